@@ -16,7 +16,7 @@ extern "C" void custom_crash_callback(struct rst_info *rst_info, uint32_t stack,
 
 void custom_crash_callback(struct rst_info *rst_info, uint32_t stack, uint32_t stack_end)
 {
-    NeoPixelEx::forceClear<decltype(pixels)::chipset_type>(pixels.kOutputPin, NEOPIXEL_NUM_PIXELS);
+    NeoPixelEx::blackoutAll();
 }
 
 void count_down(PGM_P msg, int n)
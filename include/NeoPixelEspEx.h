@@ -6,6 +6,8 @@
 
 #include <Arduino.h>
 #include <array>
+#include <atomic>
+#include <type_traits>
 
 #if ESP8266
 #    include <user_interface.h>
@@ -40,6 +42,23 @@
 #   define NEOPIXEL_HAVE_STATS 1
 #endif
 
+// count skipped frames, retries, late frames and the fps of the last second. if set to 0, the stats contain the
+// number of frames and aborted frames only
+#ifndef NEOPIXEL_HAVE_EXTENDED_STATS
+#   define NEOPIXEL_HAVE_EXTENDED_STATS 1
+#endif
+
+// track modified pixels and skip Strip::show() if nothing has changed
+// writes through raw pointers require to call markDirty()
+#ifndef NEOPIXEL_HAVE_DIRTY_TRACKING
+#   define NEOPIXEL_HAVE_DIRTY_TRACKING 0
+#endif
+
+// send unchanged frames after this interval in milliseconds, 0 to disable
+#ifndef NEOPIXEL_KEEP_ALIVE_INTERVAL
+#   define NEOPIXEL_KEEP_ALIVE_INTERVAL 1000
+#endif
+
 #if ESP8266
 // allow interrupts during the output. recommended for more than a couple pixels
 // interrupts that take too long will abort the current frame and increment NeoPixel_getAbortedFrames
@@ -83,6 +102,17 @@
 #   define NEOPIXEL_INTERRUPT_RETRY_COUNT 0
 #endif
 
+// max. number of strips in the registry of blackoutAll(), 0 to disable. max. 32
+#ifndef NEOPIXEL_MAX_REGISTERED_STRIPS
+#   define NEOPIXEL_MAX_REGISTERED_STRIPS 8
+#endif
+
+// fail to compile if the estimated cycles of the bit banging loop exceed the timings of the chipset, see
+// Timings::meetsTiming()
+#ifndef NEOPIXEL_CHECK_CYCLE_BUDGET
+#   define NEOPIXEL_CHECK_CYCLE_BUDGET 0
+#endif
+
 #define NEOPIXEL_CHIPSET_WS2811 NeoPixelEx::TimingsWS2811
 #define NEOPIXEL_CHIPSET_WS2812 NeoPixelEx::TimingsWS2812
 #define NEOPIXEL_CHIPSET_WS2813 NeoPixelEx::TimingsWS2813
@@ -137,6 +167,7 @@ namespace NeoPixelEx {
             uint8_t *begin;
             uint8_t *end;
             uint16_t brightness;
+            void *source;
             bool inUse;
         };
 
@@ -144,6 +175,115 @@ namespace NeoPixelEx {
         extern RTM_Adapter_Data_t rmtChannelsInUse[kMaxRmtChannels];
     #endif
 
+    // cycle model of the bit banging loop of the ESP8266
+    //
+    // the loop sets the output high, prepares the next bit and waits for T0H/T1H. then it sets the output low,
+    // loads the next byte at the end of each byte and waits for the end of the period. the code between the edges
+    // must fit into T0H and into the low time of a 1 bit. the low time may exceed the period by 0.6us, otherwise
+    // the frame gets aborted
+    //
+    // the costs are estimated CPU cycles counted from the generated code, including the wait loop that polls
+    // the cycle counter. the feature flags select the code that is compiled into the loop
+    namespace BitBang {
+
+        // pixel type with kReOrder
+        static constexpr uint8_t kReOrder = 0x01;
+        // NEOPIXEL_HAVE_BRIGHTNESS
+        static constexpr uint8_t kBrightness = 0x02;
+        // NEOPIXEL_ALLOW_INTERRUPTS, timeout checks
+        static constexpr uint8_t kInterrupts = 0x04;
+        // output on GPIO16, GP16O is a register of the RTC and slower than GPOS/GPOC
+        static constexpr uint8_t kGpio16 = 0x08;
+
+        // store to GPOS/GPOC including memw
+        static constexpr uint8_t kCyclesGpio = 3;
+        static constexpr uint8_t kCyclesGpio16 = 9;
+        // one iteration of the wait loop, the edge can be late by this
+        static constexpr uint8_t kCyclesPoll = 5;
+        // high phase: start time and mask shift for each bit, end of data check and offset update after the last bit
+        static constexpr uint8_t kCyclesHighBit = 6;
+        static constexpr uint8_t kCyclesHighByte = 3;
+        static constexpr uint8_t kCyclesHighReOrder = 3;
+        // low phase: end of frame and byte checks, select T0H/T1H for each bit, load the next byte after the last bit
+        static constexpr uint8_t kCyclesLowBit = 8;
+        static constexpr uint8_t kCyclesLowInterrupts = 8;
+        static constexpr uint8_t kCyclesLowByte = 5;
+        static constexpr uint8_t kCyclesLowBrightness = 4;
+        static constexpr uint8_t kCyclesLowReOrder = 7;
+
+        // features enabled by the configuration
+        static constexpr uint8_t kConfigFeatures =
+            #if NEOPIXEL_HAVE_BRIGHTNESS
+                kBrightness |
+            #endif
+            #if NEOPIXEL_ALLOW_INTERRUPTS
+                kInterrupts |
+            #endif
+            0;
+
+        // features of the loop for pin and pixel type
+        constexpr uint8_t getFeatures(uint8_t pin, bool reOrder) {
+            return kConfigFeatures | (reOrder ? kReOrder : 0) | (pin == 16 ? kGpio16 : 0);
+        }
+
+        constexpr uint32_t getCyclesGpio(uint8_t features) {
+            return (features & kGpio16) ? kCyclesGpio16 : kCyclesGpio;
+        }
+
+        // cycles after setting the output high until T0H/T1H is checked the first time, including one iteration of
+        // the wait loop. the worst case is the last bit of a byte
+        constexpr uint32_t getCyclesHigh(uint8_t features) {
+            return getCyclesGpio(features) + kCyclesHighBit + kCyclesHighByte + ((features & kReOrder) ? kCyclesHighReOrder : 0) + kCyclesPoll;
+        }
+
+        // cycles after setting the output low until the end of the period is checked the first time, including one
+        // iteration of the wait loop and the delay of the end of T1H by the previous wait loop. the worst case is
+        // loading the next byte after the last bit
+        constexpr uint32_t getCyclesLow(uint8_t features) {
+            return getCyclesGpio(features) + kCyclesLowBit + kCyclesLowByte + kCyclesPoll * 2 +
+                ((features & kInterrupts) ? kCyclesLowInterrupts : 0) +
+                ((features & kBrightness) ? kCyclesLowBrightness : 0) +
+                ((features & kReOrder) ? kCyclesLowReOrder : 0);
+        }
+
+        // output sources replace loading the next byte, the brightness and reordering with load(). a source declares
+        // the estimated worst case cycles of load() as kCyclesLoad, for sources that create a pixel before its first
+        // byte including the pixel. sources without kCyclesLoad are not checked
+
+        // read a byte and apply the brightness
+        static constexpr uint8_t kCyclesLoadByte = kCyclesLowByte + kCyclesLowBrightness;
+        // byte counter and creating the pixel before its first byte
+        static constexpr uint8_t kCyclesLoadPixel = 8;
+
+        template<typename _TPixelType>
+        constexpr uint32_t getCyclesReOrder() {
+            return _TPixelType::kReOrder ? kCyclesLowReOrder : 0;
+        }
+
+        template<typename _Type>
+        constexpr auto _getCyclesLoad(int) -> decltype(static_cast<uint32_t>(_Type::kCyclesLoad)) {
+            return _Type::kCyclesLoad;
+        }
+
+        template<typename _Type>
+        constexpr uint32_t _getCyclesLoad(long) {
+            return 0;
+        }
+
+        // kCyclesLoad of a source or a brightness mask cursor, 0 if unknown
+        template<typename _Type>
+        constexpr uint32_t getCyclesLoad() {
+            return _getCyclesLoad<_Type>(0);
+        }
+
+        // same as getCyclesLow() for _espShowSource()
+        constexpr uint32_t getCyclesLowSource(uint8_t features, uint32_t cyclesLoad) {
+            return getCyclesGpio(features) + kCyclesLowBit + kCyclesPoll * 2 +
+                ((features & kInterrupts) ? kCyclesLowInterrupts : 0) + cyclesLoad;
+        }
+
+    }
+
     // timings in nano seconds
     template<uint32_t _T0H, uint32_t _T1H, uint32_t _TPeriod, uint32_t _TReset, uint32_t _MinDisplayPeriod, uint32_t _FCpu/*Hz or MHz*/>
     class Timings {
@@ -173,9 +313,12 @@ namespace NeoPixelEx {
         static constexpr uint32_t kCyclesT1H = kNanosToCycles(_T1H);
         static constexpr uint32_t kNanosT0H = _T0H;
         static constexpr uint32_t kNanosT1H = _T1H;
+        static constexpr uint32_t kNanosPeriod = _TPeriod;
         static constexpr uint32_t kCyclesPeriod = kNanosToCycles(_TPeriod);
         static constexpr uint32_t kCyclesRES = kNanosToCycles(_TReset);
         static constexpr uint32_t kMinDisplayPeriod = _MinDisplayPeriod;
+        // cycles available between 2 bits to load the next byte from an output source before the frame gets aborted
+        static constexpr uint32_t kCyclesMaxLoad = kCyclesPeriod - kCyclesT1H + kNanosToCycles(600);
 
         static constexpr uint32_t getCyclesT0H() {
             return kNanosToCycles(_T0H);
@@ -196,6 +339,23 @@ namespace NeoPixelEx {
         static constexpr uint32_t getMinDisplayPeriod() {
             return kMinDisplayPeriod;
         }
+
+        // true if the bit banging loop with features meets T0H and the max. low time, see BitBang
+        static constexpr bool meetsTiming(uint8_t features) {
+            return BitBang::getCyclesHigh(features) <= kCyclesT0H && BitBang::getCyclesLow(features) <= kCyclesMaxLoad;
+        }
+
+        // true if _espShowSource() with features and a source that requires cyclesLoad for load() meets the timings
+        // brightness and reordering are part of load()
+        static constexpr bool meetsTimingSource(uint8_t features, uint32_t cyclesLoad) {
+            return BitBang::getCyclesHigh(features & ~(BitBang::kReOrder | BitBang::kBrightness)) <= kCyclesT0H && BitBang::getCyclesLowSource(features, cyclesLoad) <= kCyclesMaxLoad;
+        }
+
+        // richest set of features that meets the timings. the lowest bit of optional is removed first
+        // returns required if no optional feature fits
+        static constexpr uint8_t selectFeatures(uint8_t required, uint8_t optional) {
+            return (optional == 0 || meetsTiming(required | optional)) ? (required | optional) : selectFeatures(required, optional & (optional - 1));
+        }
     };
 
     template<uint32_t _FCpu>
@@ -212,10 +372,148 @@ namespace NeoPixelEx {
 
     using DefaultTimings = NEOPIXEL_CHIPSET;
 
+    // consistent copy of Stats, see Stats::getSnapshot()
+    struct StatsSnapshot {
+        uint32_t time;          // milliseconds since the stats have been cleared
+        uint32_t frames;        // frames sent including aborted frames and retries
+        uint32_t aborted;       // frames that have been aborted by interrupts
+        uint32_t retries;       // frames that have been sent again after being aborted
+        uint32_t skipped;       // frames that have been skipped because nothing has changed
+        uint32_t late;          // frames that have been sent after their deadline, see Scheduler
+        uint32_t maxLateness;   // max. time after the deadline in microseconds
+        uint16_t fps;           // average since the stats have been cleared
+        uint16_t windowFps;     // frames during the last window of kStatsWindow milliseconds
+
+        // binary format: uint8_t version, uint32_t time, frames, aborted, retries, skipped, late, maxLateness,
+        // uint16_t fps, windowFps
+        // all values are little endian
+        static constexpr uint8_t kVersion = 2;
+        static constexpr uint8_t kBinarySize = 1 + 7 * sizeof(uint32_t) + 2 * sizeof(uint16_t);
+
+        StatsSnapshot() : time(0), frames(0), aborted(0), retries(0), skipped(0), late(0), maxLateness(0), fps(0), windowFps(0) {}
+
+        // sum of multiple strips, the time is the longest time of all strips
+        StatsSnapshot &operator+=(const StatsSnapshot &stats) {
+            time = std::max(time, stats.time);
+            frames += stats.frames;
+            aborted += stats.aborted;
+            retries += stats.retries;
+            skipped += stats.skipped;
+            late += stats.late;
+            maxLateness = std::max(maxLateness, stats.maxLateness);
+            fps += stats.fps;
+            windowFps += stats.windowFps;
+            return *this;
+        }
+
+        // returns the number of bytes written or 0 if the buffer is too small
+        size_t toBinary(uint8_t *buffer, size_t size) const {
+            if (size < kBinarySize) {
+                return 0;
+            }
+            *buffer++ = kVersion;
+            for(auto value: { time, frames, aborted, retries, skipped, late, maxLateness }) {
+                buffer = _write(buffer, value, sizeof(uint32_t));
+            }
+            buffer = _write(buffer, fps, sizeof(uint16_t));
+            _write(buffer, windowFps, sizeof(uint16_t));
+            return kBinarySize;
+        }
+
+        // returns false if the size or version does not match
+        bool fromBinary(const uint8_t *buffer, size_t size) {
+            if (size < kBinarySize || *buffer++ != kVersion) {
+                return false;
+            }
+            for(auto value: { &time, &frames, &aborted, &retries, &skipped, &late, &maxLateness }) {
+                *value = _read(buffer, sizeof(uint32_t));
+                buffer += sizeof(uint32_t);
+            }
+            fps = _read(buffer, sizeof(uint16_t));
+            windowFps = _read(buffer + sizeof(uint16_t), sizeof(uint16_t));
+            return true;
+        }
+
+        // single line of key=value pairs, returns the length like snprintf()
+        int toText(char *buffer, size_t size) const {
+            return snprintf_P(buffer, size, PSTR("frames=%u aborted=%u retries=%u skipped=%u late=%u max_lateness=%u fps=%u window_fps=%u time=%u"),
+                static_cast<unsigned>(frames), static_cast<unsigned>(aborted), static_cast<unsigned>(retries), static_cast<unsigned>(skipped),
+                static_cast<unsigned>(late), static_cast<unsigned>(maxLateness), fps, windowFps, static_cast<unsigned>(time));
+        }
+
+        String toString() const {
+            char buffer[160];
+            toText(buffer, sizeof(buffer));
+            return buffer;
+        }
+
+    private:
+        static uint8_t *_write(uint8_t *buffer, uint32_t value, uint8_t size) {
+            for(uint8_t i = 0; i < size; i++) {
+                *buffer++ = value >> (i * 8);
+            }
+            return buffer;
+        }
+
+        static uint32_t _read(const uint8_t *buffer, uint8_t size) {
+            uint32_t value = 0;
+            for(uint8_t i = 0; i < size; i++) {
+                value |= static_cast<uint32_t>(buffer[i]) << (i * 8);
+            }
+            return value;
+        }
+    };
+
+    // the stats are written by the task that calls show() and can be read from any task or core with getSnapshot()
+    //
+    // the writer increments a sequence counter before and after each update. a reader retries until it gets the same
+    // even sequence before and after copying the values. the writer is never blocked and no locks are required
+    // all methods that modify the stats must be called from the task that calls show()
     class Stats {
     public:
+        // time window for getWindowFps() in milliseconds
+        static constexpr uint16_t kStatsWindow = 1000;
+
+        // max. attempts of getSnapshot() to read the values while they are being modified
+        static constexpr uint8_t kSnapshotRetries = 16;
+
+        // no time is read before the first frame and the stats can be initialized statically
+        constexpr Stats() :
+            _sequence(0),
+            _start(0),
+            _frames(0)
+            #if NEOPIXEL_ALLOW_INTERRUPTS
+                , _aborted(0)
+            #endif
+            #if NEOPIXEL_HAVE_EXTENDED_STATS
+                , _skipped(0),
+                _retries(0),
+                _late(0),
+                _maxLateness(0),
+                _windowStart(0),
+                _windowFrames(0),
+                _windowFps(0)
+            #endif
+        {
+        }
+
         void clear() {
-            *this = Stats();
+            _beginWrite();
+            _start = 0;
+            _frames = 0;
+            #if NEOPIXEL_ALLOW_INTERRUPTS
+                _aborted = 0;
+            #endif
+            #if NEOPIXEL_HAVE_EXTENDED_STATS
+                _skipped = 0;
+                _retries = 0;
+                _late = 0;
+                _maxLateness = 0;
+                _windowStart = 0;
+                _windowFrames = 0;
+                _windowFps = 0;
+            #endif
+            _endWrite();
         }
 
         uint32_t getFrames() const {
@@ -224,77 +522,216 @@ namespace NeoPixelEx {
 
         uint16_t getFps() const {
             auto time = getTime();
-            return time ? (_frames * 1000UL) / getTime() : 0;
+            return time ? (_frames * 1000ULL) / time : 0;
         }
 
-        // time since last reset in milliseconds
+        // time since the first frame in milliseconds
         uint32_t getTime() const {
-            return millis64() - _start;
+            return _frames ? millis() - _start : 0;
         }
 
-    public:
-        uint32_t &__frames() {
-            return _frames;
+    #if NEOPIXEL_ALLOW_INTERRUPTS
+        __attribute__((always_inline)) inline uint32_t getAbortedFrames() const {
+            return _aborted;
         }
 
-    protected:
-        uint64_t millis64() const {
-            #if ESP32
-                return esp_timer_get_time() / 1000;
-            #elif ESP8266
-                return micros64() / 1000;
-            #endif
+        static constexpr bool allowInterrupts() {
+            return true;
+        }
+    #else
+        static constexpr uint32_t getAbortedFrames() {
+            return 0;
         }
 
-    private:
-        uint64_t _start;
-        uint32_t _frames;
+        static constexpr bool allowInterrupts() {
+            return false;
+        }
+    #endif
 
-    public:
-    #if NEOPIXEL_ALLOW_INTERRUPTS
+    #if NEOPIXEL_HAVE_EXTENDED_STATS
+        // frames per second during the last kStatsWindow milliseconds
+        // if no frame has ended the current window, the frames of the current window are divided by the time since it
+        // started and the value drops to 0 after the frames stopped
+        uint16_t getWindowFps() const {
+            return _getWindowFps(millis());
+        }
 
-        __attribute__((always_inline)) inline Stats() : _start(millis64()), _frames(0), _aborted(0)
-        {
+        // frames that have been skipped because nothing has changed
+        uint32_t getSkippedFrames() const {
+            return _skipped;
         }
 
-        __attribute__((always_inline)) inline uint32_t getAbortedFrames() const {
-            return _aborted;
+        // frames that have been sent again after being aborted
+        uint32_t getRetries() const {
+            return _retries;
         }
 
-        static constexpr bool allowInterrupts() {
-            return true;
+        // frames that have been sent after their deadline
+        uint32_t getLateFrames() const {
+            return _late;
         }
 
-        __attribute__((always_inline)) inline void increment(bool success) {
-            _frames++;
-            if (success) {
-                return;
-            }
-            _aborted++;
+        // max. time after the deadline in microseconds
+        uint32_t getMaxLateness() const {
+            return _maxLateness;
         }
 
-    private:
-        uint32_t _aborted;
+        __attribute__((always_inline)) inline void incrementSkipped() {
+            _beginWrite();
+            _skipped++;
+            _endWrite();
+        }
+
+        __attribute__((always_inline)) inline void incrementRetries() {
+            _beginWrite();
+            _retries++;
+            _endWrite();
+        }
+
+        // lateness of a frame that has been sent by a Scheduler in microseconds
+        __attribute__((always_inline)) inline void addLateness(uint32_t lateness) {
+            if (lateness) {
+                _beginWrite();
+                _late++;
+                _maxLateness = std::max(_maxLateness, lateness);
+                _endWrite();
+            }
+        }
     #else
+        // only frames and aborted frames are counted
+        static constexpr uint16_t getWindowFps() {
+            return 0;
+        }
 
-    public:
-        __attribute__((always_inline)) inline Stats() : _start(millis64()), _frames(0)
-        {
+        static constexpr uint32_t getSkippedFrames() {
+            return 0;
         }
 
-        __attribute__((always_inline)) inline void increment(bool success) {
-            _frames++;
+        static constexpr uint32_t getRetries() {
+            return 0;
         }
 
-        static constexpr uint32_t getAbortedFrames() {
+        static constexpr uint32_t getLateFrames() {
             return 0;
         }
 
-        static constexpr bool allowInterrupts() {
-            return false;
+        static constexpr uint32_t getMaxLateness() {
+            return 0;
+        }
+
+        __attribute__((always_inline)) inline void incrementSkipped() {}
+        __attribute__((always_inline)) inline void incrementRetries() {}
+        __attribute__((always_inline)) inline void addLateness(uint32_t) {}
+    #endif
+
+        __attribute__((always_inline)) inline void increment(bool success) {
+            _beginWrite();
+            _frame();
+            #if NEOPIXEL_ALLOW_INTERRUPTS
+                if (!success) {
+                    _aborted++;
+                }
+            #endif
+            _endWrite();
+        }
+
+        // consistent copy of all values, can be called from any task or core
+        // returns false if the values have been modified during kSnapshotRetries attempts, for example if it is
+        // called from an interrupt that interrupted the writer. snapshot contains the values of the last attempt
+        bool getSnapshot(StatsSnapshot &snapshot) const {
+            uint32_t now = millis();
+            uint32_t start = 0;
+            bool consistent = false;
+            for(uint8_t i = 0; i < kSnapshotRetries && !consistent; i++) {
+                uint32_t sequence = _sequence.load(std::memory_order_acquire);
+                start = _start;
+                snapshot.frames = _frames;
+                snapshot.aborted = getAbortedFrames();
+                snapshot.retries = getRetries();
+                snapshot.skipped = getSkippedFrames();
+                snapshot.late = getLateFrames();
+                snapshot.maxLateness = getMaxLateness();
+                #if NEOPIXEL_HAVE_EXTENDED_STATS
+                    snapshot.windowFps = _getWindowFps(now);
+                #endif
+                std::atomic_thread_fence(std::memory_order_acquire);
+                // odd while the writer is active
+                consistent = !(sequence & 1) && sequence == _sequence.load(std::memory_order_relaxed);
+            }
+            snapshot.time = snapshot.frames ? now - start : 0;
+            snapshot.fps = snapshot.time ? (snapshot.frames * 1000ULL) / snapshot.time : 0;
+            return consistent;
+        }
+
+        StatsSnapshot getSnapshot() const {
+            StatsSnapshot snapshot;
+            getSnapshot(snapshot);
+            return snapshot;
+        }
+
+    public:
+        uint32_t &__frames() {
+            return _frames;
+        }
+
+    protected:
+        // there is only a single writer and the sequence does not require atomic read-modify-write
+        __attribute__((always_inline)) inline void _beginWrite() {
+            _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+        }
+
+        __attribute__((always_inline)) inline void _endWrite() {
+            _sequence.store(_sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
         }
 
+    #if NEOPIXEL_HAVE_EXTENDED_STATS
+        uint16_t _getWindowFps(uint32_t now) const {
+            uint32_t elapsed = now - _windowStart;
+            if (elapsed >= kStatsWindow) {
+                return (_windowFrames * 1000UL + elapsed / 2) / elapsed;
+            }
+            return _windowFps;
+        }
     #endif
+
+        __attribute__((always_inline)) inline void _frame() {
+            uint32_t now = millis();
+            if (!_frames) {
+                _start = now;
+                #if NEOPIXEL_HAVE_EXTENDED_STATS
+                    _windowStart = now;
+                #endif
+            }
+            _frames++;
+            #if NEOPIXEL_HAVE_EXTENDED_STATS
+                _windowFrames++;
+                uint32_t elapsed = now - _windowStart;
+                if (elapsed >= kStatsWindow) {
+                    _windowFps = (_windowFrames * 1000UL + elapsed / 2) / elapsed;
+                    _windowStart = now;
+                    _windowFrames = 0;
+                }
+            #endif
+        }
+
+    private:
+        std::atomic<uint32_t> _sequence;
+        // millis() of the first frame, 32 bit like the result of getTime()
+        uint32_t _start;
+        uint32_t _frames;
+        #if NEOPIXEL_ALLOW_INTERRUPTS
+            uint32_t _aborted;
+        #endif
+        #if NEOPIXEL_HAVE_EXTENDED_STATS
+            uint32_t _skipped;
+            uint32_t _retries;
+            uint32_t _late;
+            uint32_t _maxLateness;
+            uint32_t _windowStart;
+            uint16_t _windowFrames;
+            uint16_t _windowFps;
+        #endif
     };
 
     #if NEOPIXEL_DEBUG
@@ -395,16 +832,18 @@ namespace NeoPixelEx {
         bool _enabled;
     };
 
+    // the trigger pins are shared by all contexts
+    extern DebugContext _debugContext;
+
     #endif
 
+    // display time and stats of a strip
+    //
+    // the context can be initialized statically and does not read the time or access any pins before the first frame
+    // has been sent. strips on the same chain can share a context, see SharedContext
     class Context {
     public:
-        Context() :
-            #if NEOPIXEL_DEBUG
-                #if (NEOPIXEL_DEBUG_TRIGGER_PIN >= 0)
-                    _debug(NEOPIXEL_DEBUG_TRIGGER_PIN, NEOPIXEL_DEBUG_TRIGGER_PIN2),
-                #endif
-            #endif
+        constexpr Context() :
             _lastDisplayTime(0)
         {
         }
@@ -436,7 +875,7 @@ namespace NeoPixelEx {
 
         #if NEOPIXEL_DEBUG
             DebugContext &getDebugContext() {
-                return _debug;
+                return _debugContext;
             }
         #endif
 
@@ -447,12 +886,39 @@ namespace NeoPixelEx {
         #if NEOPIXEL_HAVE_STATS
             Stats _stats;
         #endif
-        #if NEOPIXEL_DEBUG
-            DebugContext _debug;
-        #endif
         uint32_t _lastDisplayTime;
     };
 
+    // storage of the context of a strip, the last template argument of Strip
+    //
+    // OwnContext stores the context in the strip. SharedContext uses a context with static storage duration and does
+    // not add anything to the size of the strip, for example for multiple strips on the same chain or many strips with
+    // a single status LED
+    //
+    // NeoPixelEx::Context statusContext;
+    // NeoPixelEx::Strip<4, 1, GRB, TimingsWS2812, PixelData<1, GRB>, DefaultOutput, SharedContext<statusContext>> led1;
+    class OwnContext {
+    public:
+        __attribute__((always_inline)) inline Context &getStripContext() {
+            return _context;
+        }
+
+        __attribute__((always_inline)) inline const Context &getStripContext() const {
+            return _context;
+        }
+
+    private:
+        Context _context;
+    };
+
+    template<Context &_Context>
+    class SharedContext {
+    public:
+        __attribute__((always_inline)) inline static Context &getStripContext() {
+            return _Context;
+        }
+    };
+
     struct GRBOrder {
         __attribute__((always_inline)) inline static uint8_t get(const uint8_t *ptr, const uint8_t ofs) {
             switch(ofs) {
@@ -580,6 +1046,41 @@ namespace NeoPixelEx {
         uint8_t b;
     };
 
+    class BGRType
+    {
+    public:
+        using OrderType = RGBOrder;
+
+        static constexpr bool kReOrder = false;
+
+    public:
+        BGRType() :
+            b(0),
+            g(0),
+            r(0)
+        {
+        }
+
+        BGRType(uint32_t rgb) :
+            b(static_cast<uint8_t>(rgb)),
+            g(static_cast<uint8_t>(rgb >> 8)),
+            r(static_cast<uint8_t>(rgb >> 16))
+        {
+        }
+
+        BGRType(uint8_t red, uint8_t green, uint8_t blue) :
+            b(blue),
+            g(green),
+            r(red)
+        {
+        }
+
+    public:
+        uint8_t b;
+        uint8_t g;
+        uint8_t r;
+    };
+
     template<typename _Type>
     class Color : public _Type {
     public:
@@ -647,10 +1148,10 @@ namespace NeoPixelEx {
                 *this = 0;
             }
             else {
-                brightness++;
-                red() = (red() * brightness) >> 8;
-                green() = (green() * brightness) >> 8;
-                blue() = (blue() * brightness) >> 8;
+                uint16_t scale = brightness + 1;
+                red() = (red() * scale) >> 8;
+                green() = (green() * scale) >> 8;
+                blue() = (blue() * scale) >> 8;
             }
         }
 
@@ -658,8 +1159,32 @@ namespace NeoPixelEx {
             if (brightness == 0) {
                 return Color(0);
             }
-            brightness++;
-            return Color((red() * brightness) >> 8, (green() * brightness) >> 8, (blue() * brightness) >> 8);
+            uint16_t scale = brightness + 1;
+            return Color((red() * scale) >> 8, (green() * scale) >> 8, (blue() * scale) >> 8);
+        }
+
+        // add each channel and limit to 255
+        Color addSaturate(const Color &color) const {
+            return Color(std::min(red() + color.red(), 255), std::min(green() + color.green(), 255), std::min(blue() + color.blue(), 255));
+        }
+
+        // amount 0 returns this color, 255 returns color
+        Color blend(const Color &color, uint8_t amount) const {
+            uint16_t scale = amount + (amount >> 7);
+            uint16_t inverse = 256 - scale;
+            return Color((red() * inverse + color.red() * scale) >> 8, (green() * inverse + color.green() * scale) >> 8, (blue() * inverse + color.blue() * scale) >> 8);
+        }
+
+        // amount 0 returns this color, 65535 returns color
+        Color blend16(const Color &color, uint16_t amount) const {
+            uint32_t scale = amount + (amount >> 15);
+            uint32_t inverse = 0x10000 - scale;
+            return Color((red() * inverse + color.red() * scale) >> 16, (green() * inverse + color.green() * scale) >> 16, (blue() * inverse + color.blue() * scale) >> 16);
+        }
+
+        // subtract each channel and limit to 0
+        Color subSaturate(const Color &color) const {
+            return Color(std::max(red() - color.red(), 0), std::max(green() - color.green(), 0), std::max(blue() - color.blue(), 0));
         }
 
         String toString() const {
@@ -686,59 +1211,692 @@ namespace NeoPixelEx {
     using GRB = Color<GRBType>;
     using RGB = Color<RGBType>;
     using CRGB = Color<CRGBType>; // this requires more CPU power
+    using BGR = Color<BGRType>; // APA102, SK9822
 
-    // wrapper for any raw pointer
-    template<size_t _NumElements, typename _PixelType = GRB>
-    class DataWrapper {
+    // hue, saturation and value 0-255
+    class HSV {
     public:
-        DataWrapper(void *data) : _data(reinterpret_cast<_PixelType *>(data)) {}
+        HSV() : h(0), s(0), v(0) {}
 
-        static constexpr size_t size() {
-            return _NumElements;
+        explicit HSV(uint8_t hue, uint8_t saturation = 255, uint8_t value = 255) :
+            h(hue),
+            s(saturation),
+            v(value)
+        {
         }
 
-        void fill(_PixelType color) {
-            std::fill_n(reinterpret_cast<_PixelType *>(_data), size(), color);
+        // convert to any color type
+        template<typename _ColorType>
+        _ColorType toColor() const {
+            uint8_t red, green, blue;
+            toRGB(h, s, v, red, green, blue);
+            return _ColorType(red, green, blue);
         }
 
-        _PixelType *data() {
-            return _data;
+        uint32_t toRGB() const {
+            uint8_t red, green, blue;
+            toRGB(h, s, v, red, green, blue);
+            return (red << 16) | (green << 8) | blue;
         }
 
-        const _PixelType *data() const {
-            return _data;
+        // integer conversion without divisions
+        //
+        // the hue is split into 6 sections. each section has one channel at value, one at the minimum
+        // and one rising or falling channel. the order of the channels is read from a table
+        static void toRGB(uint8_t hue, uint8_t saturation, uint8_t value, uint8_t &red, uint8_t &green, uint8_t &blue)
+        {
+            static constexpr uint8_t kChannels[6][3] = {
+                { 0, 2, 1 }, // red, rising, min
+                { 3, 0, 1 }, // falling, green, min
+                { 1, 0, 2 }, // min, green, rising
+                { 1, 3, 0 }, // min, falling, blue
+                { 2, 1, 0 }, // rising, min, blue
+                { 0, 1, 3 }, // red, min, falling
+            };
+            uint16_t hue6 = hue * 6;
+            uint8_t section = hue6 >> 8;
+            uint8_t fraction = static_cast<uint8_t>(hue6);
+            uint16_t scale = value + 1;
+            uint8_t values[4] = {
+                value,
+                static_cast<uint8_t>(((255 - saturation) * scale) >> 8),
+                static_cast<uint8_t>(((255 - ((saturation * (256 - fraction)) >> 8)) * scale) >> 8),
+                static_cast<uint8_t>(((255 - ((saturation * fraction) >> 8)) * scale) >> 8)
+            };
+            auto channels = kChannels[section];
+            red = values[channels[0]];
+            green = values[channels[1]];
+            blue = values[channels[2]];
         }
 
-        _PixelType *begin() {
-            return _data;
-        }
+    public:
+        uint8_t h;
+        uint8_t s;
+        uint8_t v;
+    };
 
-        const _PixelType *begin() const {
-            return _data;
+    // 32 bit word that may alias the pixel data
+    using alias_uint32_t = uint32_t __attribute__((__may_alias__));
+
+    // 3 byte pixels repeat every 12 byte, which are 3 aligned 32 bit words
+    // ofs is the byte of the color the period starts with
+    union PixelPeriod {
+        uint8_t bytes[12];
+        uint32_t words[3];
+
+        PixelPeriod(const uint8_t *color, uint8_t ofs) {
+            for(uint8_t i = 0; i < sizeof(bytes); i++) {
+                bytes[i] = color[ofs];
+                ofs = (ofs == 2) ? 0 : ofs + 1;
+            }
         }
+    };
 
-        _PixelType *end() {
-            return &_data[size()];
+    // bytewise operations on 4 bytes packed into a 32 bit word
+    namespace SWAR {
+
+        static constexpr uint32_t kLow7Bits = 0x7f7f7f7fUL;
+        static constexpr uint32_t kHighBits = 0x80808080UL;
+        static constexpr uint32_t kEvenBytes = 0x00ff00ffUL;
+
+        // (byte * scale) >> 8 for each byte, scale 0-256
+        __attribute__((always_inline)) inline uint32_t scale(uint32_t value, uint16_t scale)
+        {
+            // the 16 bit products of the odd and even bytes cannot overflow into the next byte
+            uint32_t even = ((value & kEvenBytes) * scale) >> 8;
+            uint32_t odd = ((value >> 8) & kEvenBytes) * scale;
+            return (even & kEvenBytes) | (odd & ~kEvenBytes);
         }
 
-        const _PixelType *end() const {
-            return &_data[size()];
+        // min(a + b, 255) for each byte
+        __attribute__((always_inline)) inline uint32_t addSaturate(uint32_t a, uint32_t b)
+        {
+            uint32_t sum = ((a & kLow7Bits) + (b & kLow7Bits)) ^ ((a ^ b) & kHighBits);
+            uint32_t carry = ((a & b) | ((a | b) & ~sum)) & kHighBits;
+            return sum | ((carry >> 7) * 0xff);
         }
 
-        _PixelType &operator[](int index) {
-            return _data[index];
+        // (from * (256 - scale) + to * scale) >> 8 for each byte, scale 0-256
+        __attribute__((always_inline)) inline uint32_t blend(uint32_t from, uint32_t to, uint16_t scale)
+        {
+            // the sum of both products is 255 * 256 max. and fits into a 16 bit lane
+            uint16_t inverse = 256 - scale;
+            uint32_t even = ((from & kEvenBytes) * inverse + (to & kEvenBytes) * scale) >> 8;
+            uint32_t odd = ((from >> 8) & kEvenBytes) * inverse + ((to >> 8) & kEvenBytes) * scale;
+            return (even & kEvenBytes) | (odd & ~kEvenBytes);
         }
 
-        _PixelType operator[](int index) const {
-            return _data[index];
+        // max(a - b, 0) for each byte
+        __attribute__((always_inline)) inline uint32_t subSaturate(uint32_t a, uint32_t b)
+        {
+            uint32_t diff = ((a | kHighBits) - (b & kLow7Bits)) ^ ((a ^ ~b) & kHighBits);
+            uint32_t borrow = ((~a & b) | ((~a | b) & diff)) & kHighBits;
+            return diff & ~((borrow >> 7) * 0xff);
         }
 
-    private:
+    }
+
+    // apply op(uint32_t word) to numBytes starting at ptr
+    // the unaligned head and tail are passed as single bytes
+    template<typename _Op>
+    inline void transformBytes(uint8_t *ptr, size_t numBytes, _Op op)
+    {
+        while ((reinterpret_cast<uintptr_t>(ptr) & 3) && numBytes) {
+            *ptr = static_cast<uint8_t>(op(*ptr));
+            ptr++;
+            numBytes--;
+        }
+        auto dst = reinterpret_cast<alias_uint32_t *>(ptr);
+        for(; numBytes >= 4; numBytes -= 4) {
+            *dst = op(*dst);
+            dst++;
+        }
+        ptr = reinterpret_cast<uint8_t *>(dst);
+        while (numBytes--) {
+            *ptr = static_cast<uint8_t>(op(*ptr));
+            ptr++;
+        }
+    }
+
+    // apply op(uint32_t word, uint32_t colorWord) to numBytes starting at ptr
+    // color is repeated every 3 byte
+    template<typename _Op>
+    inline void transformBytes(uint8_t *ptr, size_t numBytes, const uint8_t *color, _Op op)
+    {
+        uint8_t ofs = 0;
+        while ((reinterpret_cast<uintptr_t>(ptr) & 3) && numBytes) {
+            *ptr = static_cast<uint8_t>(op(*ptr, color[ofs]));
+            ptr++;
+            ofs = (ofs == 2) ? 0 : ofs + 1;
+            numBytes--;
+        }
+        PixelPeriod period(color, ofs);
+        const uint32_t w0 = period.words[0];
+        const uint32_t w1 = period.words[1];
+        const uint32_t w2 = period.words[2];
+
+        auto dst = reinterpret_cast<alias_uint32_t *>(ptr);
+        auto end = dst + (numBytes / 12) * 3;
+        while (dst < end) {
+            dst[0] = op(dst[0], w0);
+            dst[1] = op(dst[1], w1);
+            dst[2] = op(dst[2], w2);
+            dst += 3;
+        }
+
+        numBytes %= 12;
+        uint8_t n = 0;
+        for(; numBytes >= 4; numBytes -= 4) {
+            *dst = op(*dst, period.words[n++]);
+            dst++;
+        }
+        ptr = reinterpret_cast<uint8_t *>(dst);
+        for(uint8_t i = 0; i < numBytes; i++) {
+            *ptr = static_cast<uint8_t>(op(*ptr, period.bytes[n * 4 + i]));
+            ptr++;
+        }
+    }
+
+    // apply op(uint32_t word, uint32_t srcWord) to numBytes starting at ptr
+    // 32 bit words are used if ptr and src have the same alignment
+    template<typename _Op>
+    inline void transformBytes(uint8_t *ptr, const uint8_t *src, size_t numBytes, _Op op)
+    {
+        if (((reinterpret_cast<uintptr_t>(ptr) ^ reinterpret_cast<uintptr_t>(src)) & 3) == 0) {
+            while ((reinterpret_cast<uintptr_t>(ptr) & 3) && numBytes) {
+                *ptr = static_cast<uint8_t>(op(*ptr, *src++));
+                ptr++;
+                numBytes--;
+            }
+            auto dst = reinterpret_cast<alias_uint32_t *>(ptr);
+            auto srcWords = reinterpret_cast<const alias_uint32_t *>(src);
+            for(; numBytes >= 4; numBytes -= 4) {
+                *dst = op(*dst, *srcWords++);
+                dst++;
+            }
+            ptr = reinterpret_cast<uint8_t *>(dst);
+            src = reinterpret_cast<const uint8_t *>(srcWords);
+        }
+        while (numBytes--) {
+            *ptr = static_cast<uint8_t>(op(*ptr, *src++));
+            ptr++;
+        }
+    }
+
+    // fill numPixels starting at pixels with color
+    // 3 byte pixels are stored with aligned 32 bit writes
+    template<typename _PixelType>
+    inline void fillPixels(_PixelType *pixels, size_t numPixels, const _PixelType &color)
+    {
+        if __CONSTEXPR17 (sizeof(_PixelType) != 3) {
+            std::fill_n(pixels, numPixels, color);
+        }
+        else {
+            transformBytes(reinterpret_cast<uint8_t *>(pixels), numPixels * 3, reinterpret_cast<const uint8_t *>(&color), [](uint32_t, uint32_t color) {
+                return color;
+            });
+        }
+    }
+
+    // same as Color::scale() for numPixels starting at pixels
+    template<typename _PixelType>
+    inline void scalePixels(_PixelType *pixels, size_t numPixels, uint8_t brightness)
+    {
+        uint16_t scale = brightness ? brightness + 1 : 0;
+        transformBytes(reinterpret_cast<uint8_t *>(pixels), numPixels * sizeof(_PixelType), [scale](uint32_t value) {
+            return SWAR::scale(value, scale);
+        });
+    }
+
+    // same as Color::addSaturate() for numPixels starting at pixels
+    template<typename _PixelType>
+    inline void addSaturatePixels(_PixelType *pixels, size_t numPixels, const _PixelType &color)
+    {
+        static_assert(sizeof(_PixelType) == 3, "3 byte pixel type required");
+        transformBytes(reinterpret_cast<uint8_t *>(pixels), numPixels * 3, reinterpret_cast<const uint8_t *>(&color), SWAR::addSaturate);
+    }
+
+    template<typename _PixelType>
+    inline void addSaturatePixels(_PixelType *pixels, const _PixelType *src, size_t numPixels)
+    {
+        transformBytes(reinterpret_cast<uint8_t *>(pixels), reinterpret_cast<const uint8_t *>(src), numPixels * sizeof(_PixelType), SWAR::addSaturate);
+    }
+
+    // same as Color::subSaturate() for numPixels starting at pixels
+    template<typename _PixelType>
+    inline void subSaturatePixels(_PixelType *pixels, size_t numPixels, const _PixelType &color)
+    {
+        static_assert(sizeof(_PixelType) == 3, "3 byte pixel type required");
+        transformBytes(reinterpret_cast<uint8_t *>(pixels), numPixels * 3, reinterpret_cast<const uint8_t *>(&color), SWAR::subSaturate);
+    }
+
+    template<typename _PixelType>
+    inline void subSaturatePixels(_PixelType *pixels, const _PixelType *src, size_t numPixels)
+    {
+        transformBytes(reinterpret_cast<uint8_t *>(pixels), reinterpret_cast<const uint8_t *>(src), numPixels * sizeof(_PixelType), SWAR::subSaturate);
+    }
+
+    // apply op(uint32_t fromWord, uint32_t toWord) to numBytes and store the result in ptr
+    // 32 bit words are used if all pointers have the same alignment
+    template<typename _Op>
+    inline void transformBytes(uint8_t *ptr, const uint8_t *from, const uint8_t *to, size_t numBytes, _Op op)
+    {
+        auto addr = reinterpret_cast<uintptr_t>(ptr);
+        if ((((addr ^ reinterpret_cast<uintptr_t>(from)) | (addr ^ reinterpret_cast<uintptr_t>(to))) & 3) == 0) {
+            while ((reinterpret_cast<uintptr_t>(ptr) & 3) && numBytes) {
+                *ptr++ = static_cast<uint8_t>(op(*from++, *to++));
+                numBytes--;
+            }
+            auto dst = reinterpret_cast<alias_uint32_t *>(ptr);
+            auto fromWords = reinterpret_cast<const alias_uint32_t *>(from);
+            auto toWords = reinterpret_cast<const alias_uint32_t *>(to);
+            for(; numBytes >= 4; numBytes -= 4) {
+                *dst++ = op(*fromWords++, *toWords++);
+            }
+            ptr = reinterpret_cast<uint8_t *>(dst);
+            from = reinterpret_cast<const uint8_t *>(fromWords);
+            to = reinterpret_cast<const uint8_t *>(toWords);
+        }
+        while (numBytes--) {
+            *ptr++ = static_cast<uint8_t>(op(*from++, *to++));
+        }
+    }
+
+    // converts the blend amount 0-255 to 0-256
+    __attribute__((always_inline)) inline uint16_t blendAmount(uint8_t amount)
+    {
+        return amount + (amount >> 7);
+    }
+
+    // converts the blend amount 0-65535 to 0-65536
+    __attribute__((always_inline)) inline uint32_t blendAmount16(uint16_t amount)
+    {
+        return amount + (amount >> 15);
+    }
+
+    // same as Color::blend() for numPixels. pixels may be equal to from or to
+    template<typename _PixelType>
+    inline void blendPixels(_PixelType *pixels, const _PixelType *from, const _PixelType *to, size_t numPixels, uint8_t amount)
+    {
+        uint16_t scale = blendAmount(amount);
+        transformBytes(reinterpret_cast<uint8_t *>(pixels), reinterpret_cast<const uint8_t *>(from), reinterpret_cast<const uint8_t *>(to), numPixels * sizeof(_PixelType), [scale](uint32_t from, uint32_t to) {
+            return SWAR::blend(from, to, scale);
+        });
+    }
+
+    // same as Color::blend16() for numPixels. pixels may be equal to from or to
+    //
+    // the product of a byte and a 16 bit amount does not fit into a 16 bit lane, each byte is blended separately
+    template<typename _PixelType>
+    inline void blendPixels16(_PixelType *pixels, const _PixelType *from, const _PixelType *to, size_t numPixels, uint16_t amount)
+    {
+        uint32_t scale = blendAmount16(amount);
+        auto dst = reinterpret_cast<uint8_t *>(pixels);
+        auto src1 = reinterpret_cast<const uint8_t *>(from);
+        auto src2 = reinterpret_cast<const uint8_t *>(to);
+        auto end = dst + numPixels * sizeof(_PixelType);
+        while (dst < end) {
+            *dst++ = (*src1++ * (0x10000 - scale) + *src2++ * scale) >> 16;
+        }
+    }
+
+    // rainbow starting with the hue of start and adding deltaHue for each pixel
+    // step is the distance between 2 pixels
+    template<typename _PixelType>
+    inline void rainbowPixels(_PixelType *pixels, size_t numPixels, const HSV &start, uint8_t deltaHue, int16_t step = 1)
+    {
+        uint8_t hue = start.h;
+        uint8_t red, green, blue;
+        // pixels is not advanced past the last pixel, which is outside the buffer for a negative step
+        while (numPixels) {
+            HSV::toRGB(hue, start.s, start.v, red, green, blue);
+            *pixels = _PixelType(red, green, blue);
+            hue += deltaHue;
+            if (--numPixels) {
+                pixels += step;
+            }
+        }
+    }
+
+    // linear gradient from the first to the last pixel, step is the distance between 2 pixels
+    // each channel is stepped with a 16.16 fixed point value
+    template<typename _PixelType>
+    inline void gradientPixels(_PixelType *pixels, size_t numPixels, const _PixelType &from, const _PixelType &to, int16_t step = 1)
+    {
+        if (numPixels == 0) {
+            return;
+        }
+        int32_t steps = numPixels > 1 ? numPixels - 1 : 1;
+        int32_t red = (from.red() << 16) + 0x8000;
+        int32_t green = (from.green() << 16) + 0x8000;
+        int32_t blue = (from.blue() << 16) + 0x8000;
+        // the delta is negative for falling channels and cannot be shifted
+        int32_t redStep = ((to.red() - from.red()) * 0x10000) / steps;
+        int32_t greenStep = ((to.green() - from.green()) * 0x10000) / steps;
+        int32_t blueStep = ((to.blue() - from.blue()) * 0x10000) / steps;
+        while (numPixels) {
+            *pixels = _PixelType(red >> 16, green >> 16, blue >> 16);
+            red += redStep;
+            green += greenStep;
+            blue += blueStep;
+            if (--numPixels) {
+                pixels += step;
+            }
+        }
+    }
+
+    // gradient with increasing hue from the first to the last pixel
+    template<typename _PixelType>
+    inline void gradientPixels(_PixelType *pixels, size_t numPixels, const HSV &from, const HSV &to, int16_t step = 1)
+    {
+        if (numPixels == 0) {
+            return;
+        }
+        int32_t steps = numPixels > 1 ? numPixels - 1 : 1;
+        uint32_t hue = (from.h << 16) + 0x8000;
+        int32_t saturation = (from.s << 16) + 0x8000;
+        int32_t value = (from.v << 16) + 0x8000;
+        // the hue always increases, saturation and value may decrease
+        uint32_t hueStep = (static_cast<uint8_t>(to.h - from.h) << 16) / steps;
+        int32_t saturationStep = ((to.s - from.s) * 0x10000) / steps;
+        int32_t valueStep = ((to.v - from.v) * 0x10000) / steps;
+        uint8_t red, green, blue;
+        while (numPixels) {
+            HSV::toRGB(static_cast<uint8_t>(hue >> 16), saturation >> 16, value >> 16, red, green, blue);
+            *pixels = _PixelType(red, green, blue);
+            hue += hueStep;
+            saturation += saturationStep;
+            value += valueStep;
+            if (--numPixels) {
+                pixels += step;
+            }
+        }
+    }
+
+    // range of pixels that have been modified since the last call of clearDirty()
+    class DirtyTracking {
+    public:
+    #if NEOPIXEL_HAVE_DIRTY_TRACKING
+        DirtyTracking() : _begin(0), _end(0xffff) {}
+
+        void markDirty() {
+            _begin = 0;
+            _end = 0xffff;
+        }
+
+        void markDirty(uint16_t index) {
+            _begin = std::min(_begin, index);
+            _end = std::max<uint16_t>(_end, index + 1);
+        }
+
+        void markDirty(uint16_t offset, uint16_t numPixels) {
+            if (numPixels) {
+                _begin = std::min(_begin, offset);
+                _end = std::max<uint16_t>(_end, std::min<uint32_t>(offset + numPixels, 0xffff));
+            }
+        }
+
+        bool isDirty() const {
+            return _begin < _end;
+        }
+
+        void clearDirty() {
+            _begin = 0xffff;
+            _end = 0;
+        }
+
+        // first modified pixel
+        uint16_t getDirtyBegin() const {
+            return _begin;
+        }
+
+        // last modified pixel + 1, 0xffff if all pixels have been marked
+        uint16_t getDirtyEnd() const {
+            return _end;
+        }
+
+    private:
+        uint16_t _begin;
+        uint16_t _end;
+    #else
+        void markDirty() {}
+        void markDirty(uint16_t) {}
+        void markDirty(uint16_t, uint16_t) {}
+        void clearDirty() {}
+
+        static constexpr bool isDirty() {
+            return true;
+        }
+    #endif
+    };
+
+    template<typename _Ta>
+    inline void _markDirtyRange(_Ta &data, uint16_t offset, uint16_t numPixels, std::true_type) {
+        data.markDirty(offset, numPixels);
+    }
+
+    template<typename _Ta>
+    inline void _markDirtyRange(_Ta &, uint16_t, uint16_t, std::false_type) {
+    }
+
+    // mark pixels as modified if data supports dirty tracking
+    template<typename _Ta>
+    inline void markDirtyRange(_Ta &data, uint16_t offset, uint16_t numPixels) {
+        _markDirtyRange(data, offset, numPixels, std::is_base_of<DirtyTracking, _Ta>());
+    }
+
+    template<typename _Ta>
+    inline DirtyTracking *_getDirtyTracking(_Ta &data, std::true_type) {
+        return &data;
+    }
+
+    template<typename _Ta>
+    inline DirtyTracking *_getDirtyTracking(_Ta &, std::false_type) {
+        return nullptr;
+    }
+
+    // dirty tracking of data or nullptr, for objects that keep a pointer to the pixels and modify them later
+    template<typename _Ta>
+    inline DirtyTracking *getDirtyTracking(_Ta &data) {
+        return _getDirtyTracking(data, std::is_base_of<DirtyTracking, _Ta>());
+    }
+
+    // functions that modify multiple pixels at once
+    // _Derived must provide data() and size()
+    //
+    // the range functions take offset and the number of pixels like Strip::fill() and Segment. the only exception is
+    // PixelData::fill(offset, end, color), which takes an end index for compatibility
+    template<typename _Derived, typename _PixelType>
+    class PixelKernels : public DirtyTracking {
+    public:
+        // fill numPixels starting at offset
+        void fillN(uint16_t offset, uint16_t numPixels, const _PixelType &color) {
+            markDirty(offset, numPixels);
+            fillPixels(_pixels() + offset, numPixels, color);
+        }
+
+        // Color::scale() for all pixels
+        void scaleAll(uint8_t brightness) {
+            markDirty();
+            scalePixels(_pixels(), _size(), brightness);
+        }
+
+        // Color::scale() for numPixels starting at offset
+        void scale(uint16_t offset, uint16_t numPixels, uint8_t brightness) {
+            markDirty(offset, numPixels);
+            scalePixels(_pixels() + offset, numPixels, brightness);
+        }
+
+        // reduce brightness by amount/256th
+        void fadeBy(uint8_t amount) {
+            markDirty();
+            scalePixels(_pixels(), _size(), 255 - amount);
+        }
+
+        void fadeBy(uint16_t offset, uint16_t numPixels, uint8_t amount) {
+            markDirty(offset, numPixels);
+            scalePixels(_pixels() + offset, numPixels, 255 - amount);
+        }
+
+        // Color::addSaturate() for all pixels
+        void addSaturate(const _PixelType &color) {
+            markDirty();
+            addSaturatePixels(_pixels(), _size(), color);
+        }
+
+        void addSaturate(uint16_t offset, uint16_t numPixels, const _PixelType &color) {
+            markDirty(offset, numPixels);
+            addSaturatePixels(_pixels() + offset, numPixels, color);
+        }
+
+        // Color::subSaturate() for all pixels
+        void subSaturate(const _PixelType &color) {
+            markDirty();
+            subSaturatePixels(_pixels(), _size(), color);
+        }
+
+        void subSaturate(uint16_t offset, uint16_t numPixels, const _PixelType &color) {
+            markDirty(offset, numPixels);
+            subSaturatePixels(_pixels() + offset, numPixels, color);
+        }
+
+        // blend this pixels with to
+        // amount 0 keeps the current pixels, 255 copies to
+        template<typename _Ta>
+        void blend(const _Ta &to, uint8_t amount) {
+            markDirty();
+            blendPixels(_pixels(), _pixels(), to.data(), _size(), amount);
+        }
+
+        // store the blended pixels of from and to
+        template<typename _Ta, typename _Tb>
+        void blend(const _Ta &from, const _Tb &to, uint8_t amount) {
+            markDirty();
+            blendPixels(_pixels(), from.data(), to.data(), _size(), amount);
+        }
+
+        // amount 0 keeps the current pixels, 65535 copies to
+        template<typename _Ta>
+        void blend16(const _Ta &to, uint16_t amount) {
+            markDirty();
+            blendPixels16(_pixels(), _pixels(), to.data(), _size(), amount);
+        }
+
+        template<typename _Ta, typename _Tb>
+        void blend16(const _Ta &from, const _Tb &to, uint16_t amount) {
+            markDirty();
+            blendPixels16(_pixels(), from.data(), to.data(), _size(), amount);
+        }
+
+        // same as FastLED fill_rainbow()
+        void fillRainbow(uint8_t startHue, uint8_t deltaHue) {
+            markDirty();
+            rainbowPixels(_pixels(), _size(), HSV(startHue), deltaHue);
+        }
+
+        void fillRainbow(const HSV &start, uint8_t deltaHue) {
+            markDirty();
+            rainbowPixels(_pixels(), _size(), start, deltaHue);
+        }
+
+        void fillRainbow(uint16_t offset, uint16_t numPixels, uint8_t startHue, uint8_t deltaHue) {
+            markDirty(offset, numPixels);
+            rainbowPixels(_pixels() + offset, numPixels, HSV(startHue), deltaHue);
+        }
+
+        void fillRainbow(uint16_t offset, uint16_t numPixels, const HSV &start, uint8_t deltaHue) {
+            markDirty(offset, numPixels);
+            rainbowPixels(_pixels() + offset, numPixels, start, deltaHue);
+        }
+
+        // RGB gradient over all pixels
+        void fillGradient(const _PixelType &from, const _PixelType &to) {
+            markDirty();
+            gradientPixels(_pixels(), _size(), from, to);
+        }
+
+        void fillGradient(uint16_t offset, uint16_t numPixels, const _PixelType &from, const _PixelType &to) {
+            markDirty(offset, numPixels);
+            gradientPixels(_pixels() + offset, numPixels, from, to);
+        }
+
+        // HSV gradient with increasing hue over all pixels
+        void fillGradient(const HSV &from, const HSV &to) {
+            markDirty();
+            gradientPixels(_pixels(), _size(), from, to);
+        }
+
+        void fillGradient(uint16_t offset, uint16_t numPixels, const HSV &from, const HSV &to) {
+            markDirty(offset, numPixels);
+            gradientPixels(_pixels() + offset, numPixels, from, to);
+        }
+
+    private:
+        _PixelType *_pixels() {
+            return static_cast<_Derived *>(this)->data();
+        }
+
+        size_t _size() const {
+            return static_cast<const _Derived *>(this)->size();
+        }
+    };
+
+    // wrapper for any raw pointer
+    template<size_t _NumElements, typename _PixelType = GRB>
+    class DataWrapper : public PixelKernels<DataWrapper<_NumElements, _PixelType>, _PixelType> {
+    public:
+        DataWrapper(void *data) : _data(reinterpret_cast<_PixelType *>(data)) {}
+
+        static constexpr size_t size() {
+            return _NumElements;
+        }
+
+        void fill(_PixelType color) {
+            this->markDirty();
+            fillPixels(_data, size(), color);
+        }
+
+        _PixelType *data() {
+            return _data;
+        }
+
+        const _PixelType *data() const {
+            return _data;
+        }
+
+        _PixelType *begin() {
+            this->markDirty();
+            return _data;
+        }
+
+        const _PixelType *begin() const {
+            return _data;
+        }
+
+        _PixelType *end() {
+            this->markDirty();
+            return &_data[size()];
+        }
+
+        const _PixelType *end() const {
+            return &_data[size()];
+        }
+
+        _PixelType &operator[](int index) {
+            this->markDirty(index);
+            return _data[index];
+        }
+
+        _PixelType operator[](int index) const {
+            return _data[index];
+        }
+
+    private:
         _PixelType *_data;
     };
 
     template<uint16_t _NumPixels, typename _PixelType = GRB, typename _DataType = std::array<_PixelType, _NumPixels>>
-    class PixelData
+    class PixelData : public PixelKernels<PixelData<_NumPixels, _PixelType, _DataType>, _PixelType>
     {
     public:
         using data_type = std::array<_PixelType, _NumPixels>;
@@ -753,103 +1911,1106 @@ namespace NeoPixelEx {
         template<typename ..._Args>
         PixelData(_Args &&...args) : _data(std::forward<_Args &&>(args)...) {}
 
-        static  constexpr uint16_t getNumBytes() {
-            return kNumBytes;
+        static  constexpr uint16_t getNumBytes() {
+            return kNumBytes;
+        }
+
+        static constexpr uint16_t getNumPixels() {
+            return kNumPixels;
+        }
+
+        static constexpr uint16_t size() {
+            return kNumPixels;
+        }
+
+        pixel_type *data() {
+            return _data.data();
+        }
+
+        const pixel_type *data() const {
+            return _data.data();
+        }
+
+        pixel_type *begin() {
+            this->markDirty();
+            return data();
+        }
+
+        const pixel_type *begin() const {
+            return data();
+        }
+
+        pixel_type *end() {
+            this->markDirty();
+            return &data()[_data.size()];
+        }
+
+        const pixel_type *end() const {
+            return &data()[_data.size()];
+        }
+
+        explicit operator const pixel_type *() const {
+            return reinterpret_cast<const pixel_type *>(data());
+        }
+
+        explicit operator pixel_type *() {
+            this->markDirty();
+            return reinterpret_cast<pixel_type *>(data());
+        }
+
+        operator const uint8_t *() const {
+            return reinterpret_cast<const uint8_t *>(data());
+        }
+
+        operator uint8_t *() {
+            this->markDirty();
+            return reinterpret_cast<uint8_t *>(data());
+        }
+
+        void set(int index, pixel_type color) {
+            this->markDirty(index);
+            data()[index] = color;
+        }
+
+        pixel_type get(int index) const {
+            return data()[index];
+        }
+
+        pixel_type &operator[](int index) {
+            this->markDirty(index);
+            return data()[index];
+        }
+
+        pixel_type operator[](int index) const {
+            return data()[index];
+        }
+
+        // color is RGB
+        void fill(uint32_t color) {
+            fill(pixel_type(color));
+        }
+
+        void fill(const pixel_type &color) {
+            this->markDirty();
+            fillPixels(data(), size(), color);
+        }
+
+        // color is RGB
+        void fill(uint16_t numPixels, uint32_t color) {
+            fill(numPixels, pixel_type(color));
+        }
+
+        void fill(uint16_t numPixels, const pixel_type &color) {
+            this->markDirty(0, numPixels);
+            fillPixels(data(), numPixels, color);
+        }
+
+        // color is RGB
+        void fill(uint16_t offset, uint16_t end, uint32_t color) {
+            fill(offset, end, pixel_type(color));
+        }
+
+        // fills the pixels from offset to end - 1. unlike the other range functions, the second argument is not the
+        // number of pixels, see fillN()
+        void fill(uint16_t offset, uint16_t end, const pixel_type &color) {
+            if (offset < end) {
+                this->markDirty(offset, end - offset);
+                fillPixels(data() + offset, end - offset, color);
+            }
+        }
+
+    private:
+        // aligned for the 32 bit kernels
+        alignas(4) data_type _data;
+    };
+
+    // view of a part of a pixel buffer
+    //
+    // the segment has numPixels pixels starting at offset with a distance of step pixels. a negative step reverses
+    // the direction and the first pixel of the segment is the last one in the buffer
+    // iterators and bulk functions advance a pointer by step instead of calculating the index of each pixel. the
+    // pointer is not advanced past the last pixel, which is outside the buffer for reversed segments. end() is a
+    // sentinel with no pixels remaining
+    // segments with a step of 1 or -1 use the 32 bit kernels if the order of the pixels does not matter
+    // segments created from a data type with dirty tracking mark the pixels they modify. non-const begin() and
+    // operator[] mark the pixels as well, since they return references
+    template<typename _PixelType = GRB>
+    class Segment {
+    public:
+        using pixel_type = _PixelType;
+
+        class iterator {
+        public:
+            iterator(pixel_type *ptr, uint16_t remaining, int16_t step) : _ptr(ptr), _remaining(remaining), _step(step) {}
+
+            pixel_type &operator*() const {
+                return *_ptr;
+            }
+
+            pixel_type *operator->() const {
+                return _ptr;
+            }
+
+            iterator &operator++() {
+                if (--_remaining) {
+                    _ptr += _step;
+                }
+                return *this;
+            }
+
+            // iterators of the same segment only
+            bool operator==(const iterator &iter) const {
+                return _remaining == iter._remaining;
+            }
+
+            bool operator!=(const iterator &iter) const {
+                return _remaining != iter._remaining;
+            }
+
+        private:
+            friend Segment;
+
+            pixel_type *_ptr;
+            uint16_t _remaining;
+            int16_t _step;
+        };
+
+    public:
+        Segment(pixel_type *pixels, uint16_t offset, uint16_t numPixels, int16_t step = 1) :
+            _first(pixels + offset + ((step < 0 && numPixels) ? (numPixels - 1) * -step : 0)),
+            _size(numPixels),
+            _step(step)
+            #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                , _dirty(nullptr),
+                _pixels(pixels)
+            #endif
+        {
+        }
+
+        // any type that provides data(), for example PixelData, DataWrapper or Strip::data()
+        template<typename _Ta>
+        Segment(_Ta &data, uint16_t offset, uint16_t numPixels, int16_t step = 1) : Segment(data.data(), offset, numPixels, step) {
+            #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                _dirty = getDirtyTracking(data);
+            #endif
+        }
+
+        uint16_t size() const {
+            return _size;
+        }
+
+        uint16_t getNumPixels() const {
+            return _size;
+        }
+
+        int16_t getStep() const {
+            return _step;
+        }
+
+        bool isReversed() const {
+            return _step < 0;
+        }
+
+        // numPixels starting at offset of this segment
+        Segment subSegment(uint16_t offset, uint16_t numPixels) const {
+            return Segment(*this, _first + offset * _step, numPixels);
+        }
+
+        iterator begin() {
+            _markDirty();
+            return iterator(_first, _size, _step);
+        }
+
+        iterator begin() const {
+            return iterator(_first, _size, _step);
+        }
+
+        iterator end() const {
+            return iterator(_first, 0, _step);
+        }
+
+        pixel_type &operator[](int index) {
+            _markDirty(index);
+            return _first[index * _step];
+        }
+
+        pixel_type operator[](int index) const {
+            return _first[index * _step];
+        }
+
+        void set(int index, pixel_type color) {
+            _markDirty(index);
+            _first[index * _step] = color;
+        }
+
+        pixel_type get(int index) const {
+            return _first[index * _step];
+        }
+
+        // color is RGB
+        void fill(uint32_t color) {
+            fill(pixel_type(color));
+        }
+
+        void fill(const pixel_type &color) {
+            _markDirty();
+            if (_isContiguous()) {
+                fillPixels(_lowest(), _size, color);
+            }
+            else {
+                _forEach([&color](const pixel_type &) {
+                    return color;
+                });
+            }
+        }
+
+        // numPixels is the number of pixels like PixelData::fillN(), not an end index like PixelData::fill()
+        void fill(uint16_t offset, uint16_t numPixels, const pixel_type &color) {
+            subSegment(offset, numPixels).fill(color);
+        }
+
+        // Color::scale() for all pixels
+        void scaleAll(uint8_t brightness) {
+            _markDirty();
+            if (_isContiguous()) {
+                scalePixels(_lowest(), _size, brightness);
+            }
+            else {
+                _forEach([brightness](const pixel_type &pixel) {
+                    return pixel.scale(brightness);
+                });
+            }
+        }
+
+        // reduce brightness by amount/256th
+        void fadeBy(uint8_t amount) {
+            scaleAll(255 - amount);
+        }
+
+        // Color::addSaturate() for all pixels
+        void addSaturate(const pixel_type &color) {
+            _markDirty();
+            if (_isContiguous()) {
+                addSaturatePixels(_lowest(), _size, color);
+            }
+            else {
+                _forEach([&color](const pixel_type &pixel) {
+                    return pixel.addSaturate(color);
+                });
+            }
+        }
+
+        // Color::subSaturate() for all pixels
+        void subSaturate(const pixel_type &color) {
+            _markDirty();
+            if (_isContiguous()) {
+                subSaturatePixels(_lowest(), _size, color);
+            }
+            else {
+                _forEach([&color](const pixel_type &pixel) {
+                    return pixel.subSaturate(color);
+                });
+            }
+        }
+
+        // blend this pixels with to, which provides the pixels in the order of the segment
+        // amount 0 keeps the current pixels, 255 copies to
+        template<typename _Ta>
+        void blend(const _Ta &to, uint8_t amount) {
+            blend(*this, to, amount);
+        }
+
+        // store the blended pixels of from and to
+        template<typename _Ta, typename _Tb>
+        void blend(const _Ta &from, const _Tb &to, uint8_t amount) {
+            _blend(from.begin(), to.begin(), [amount](const pixel_type &from, const pixel_type &to) {
+                return from.blend(to, amount);
+            }, [amount](pixel_type *pixels, const pixel_type *from, const pixel_type *to, size_t numPixels) {
+                blendPixels(pixels, from, to, numPixels, amount);
+            });
+        }
+
+        // amount 0 keeps the current pixels, 65535 copies to
+        template<typename _Ta>
+        void blend16(const _Ta &to, uint16_t amount) {
+            blend16(*this, to, amount);
+        }
+
+        template<typename _Ta, typename _Tb>
+        void blend16(const _Ta &from, const _Tb &to, uint16_t amount) {
+            _blend(from.begin(), to.begin(), [amount](const pixel_type &from, const pixel_type &to) {
+                return from.blend16(to, amount);
+            }, [amount](pixel_type *pixels, const pixel_type *from, const pixel_type *to, size_t numPixels) {
+                blendPixels16(pixels, from, to, numPixels, amount);
+            });
+        }
+
+        // same as FastLED fill_rainbow()
+        void fillRainbow(uint8_t startHue, uint8_t deltaHue) {
+            _markDirty();
+            rainbowPixels(_first, _size, HSV(startHue), deltaHue, _step);
+        }
+
+        void fillRainbow(const HSV &start, uint8_t deltaHue) {
+            _markDirty();
+            rainbowPixels(_first, _size, start, deltaHue, _step);
+        }
+
+        // RGB gradient over all pixels
+        void fillGradient(const pixel_type &from, const pixel_type &to) {
+            _markDirty();
+            gradientPixels(_first, _size, from, to, _step);
+        }
+
+        // HSV gradient with increasing hue over all pixels
+        void fillGradient(const HSV &from, const HSV &to) {
+            _markDirty();
+            gradientPixels(_first, _size, from, to, _step);
+        }
+
+    private:
+        // sub segment of parent, first is the first pixel of the segment and not the pixel at the lowest address
+        Segment(const Segment &parent, pixel_type *first, uint16_t numPixels) :
+            _first(first),
+            _size(numPixels),
+            _step(parent._step)
+            #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                , _dirty(parent._dirty),
+                _pixels(parent._pixels)
+            #endif
+        {
+        }
+
+        #if NEOPIXEL_HAVE_DIRTY_TRACKING
+            // all pixels between the first and the last pixel of the segment
+            void _markDirty() {
+                if (_dirty && _size) {
+                    _dirty->markDirty(_lowest() - _pixels, (_size - 1) * abs(_step) + 1);
+                }
+            }
+
+            void _markDirty(int index) {
+                if (_dirty) {
+                    _dirty->markDirty(_first + index * _step - _pixels);
+                }
+            }
+        #else
+            void _markDirty() {}
+            void _markDirty(int) {}
+        #endif
+
+        bool _isContiguous() const {
+            return _step == 1 || _step == -1;
+        }
+
+        // first pixel in memory
+        pixel_type *_lowest() const {
+            return (_step < 0 && _size) ? _first + (_size - 1) * _step : _first;
+        }
+
+        template<typename _Op>
+        void _forEach(_Op op) {
+            auto ptr = _first;
+            for(uint16_t i = _size; i; ) {
+                *ptr = op(*ptr);
+                if (--i) {
+                    ptr += _step;
+                }
+            }
+        }
+
+        // uses the 32 bit kernel if all pixels are stored in the same order
+        template<typename _TaIter, typename _TbIter, typename _Op, typename _Kernel>
+        void _blend(_TaIter from, _TbIter to, _Op op, _Kernel kernel) {
+            _markDirty();
+            auto fromPixels = _contiguous(from);
+            auto toPixels = _contiguous(to);
+            if (_step == 1 && fromPixels && toPixels) {
+                kernel(_first, fromPixels, toPixels, _size);
+                return;
+            }
+            auto ptr = _first;
+            for(uint16_t i = _size; i; ++from, ++to) {
+                *ptr = op(*from, *to);
+                if (--i) {
+                    ptr += _step;
+                }
+            }
+        }
+
+        static const pixel_type *_contiguous(const pixel_type *ptr) {
+            return ptr;
+        }
+
+        static const pixel_type *_contiguous(const iterator &iter) {
+            return iter._step == 1 ? iter._ptr : nullptr;
+        }
+
+    private:
+        pixel_type *_first;
+        uint16_t _size;
+        int16_t _step;
+        #if NEOPIXEL_HAVE_DIRTY_TRACKING
+            DirtyTracking *_dirty;
+            pixel_type *_pixels;
+        #endif
+    };
+
+    // reads the bytes of a pixel in the order they are sent
+    template<typename _TPixelType>
+    class PixelOrder {
+    public:
+        PixelOrder() : _ofs(1) {}
+
+        __attribute__((always_inline)) inline uint8_t get(const uint8_t *ptr) const {
+            if __CONSTEXPR17 (_TPixelType::kReOrder) {
+                return _TPixelType::OrderType::get(ptr, _ofs);
+            }
+            else {
+                return *ptr;
+            }
+        }
+
+        // advance to the next byte
+        __attribute__((always_inline)) inline void next() {
+            if __CONSTEXPR17 (_TPixelType::kReOrder) {
+                _ofs = (_ofs == sizeof(_TPixelType) - 1) ? 0 : _ofs + 1;
+            }
+        }
+
+    private:
+        uint8_t _ofs;
+    };
+
+    // output sources create the data while it is being sent
+    //
+    // bool available() const
+    // returns true if there is more data
+    //
+    // uint8_t load()
+    // returns the next byte with brightness applied. it is called between 2 bits and must be inlined
+    //
+    // static constexpr uint8_t kCyclesLoad
+    // optional estimate of the CPU cycles of load(), see BitBang
+    //
+    // sources are copied for each attempt to send a frame
+
+    // blends 2 pixel buffers without storing the result
+    // brightness is 0-256
+    template<typename _TPixelType>
+    class BlendSource {
+    public:
+        static constexpr uint8_t kCyclesLoad = BitBang::kCyclesLoadByte * 2 + BitBang::getCyclesReOrder<_TPixelType>();
+
+        BlendSource(const uint8_t *from, const uint8_t *to, uint16_t numBytes, uint8_t amount, uint16_t brightness) :
+            _from(from),
+            _to(to),
+            _end(from + numBytes),
+            _scale(blendAmount(amount)),
+            _brightness(brightness)
+        {
+        }
+
+        __attribute__((always_inline)) inline bool available() const {
+            return _from < _end;
+        }
+
+        __attribute__((always_inline)) inline uint8_t load() {
+            uint8_t value = (_order.get(_from++) * (256 - _scale) + _order.get(_to++) * _scale) >> 8;
+            _order.next();
+            return (value * _brightness) >> 8;
+        }
+
+    private:
+        const uint8_t *_from;
+        const uint8_t *_to;
+        const uint8_t *_end;
+        uint16_t _scale;
+        uint16_t _brightness;
+        PixelOrder<_TPixelType> _order;
+    };
+
+    // pixel buffer with brightness 0-256, the bytes are the same as sent by the default output
+    template<typename _TPixelType>
+    class PixelSource {
+    public:
+        static constexpr uint8_t kCyclesLoad = BitBang::kCyclesLoadByte + BitBang::getCyclesReOrder<_TPixelType>();
+
+        PixelSource(const uint8_t *pixels, uint16_t numBytes, uint16_t brightness) :
+            _ptr(pixels),
+            _end(pixels + numBytes),
+            _brightness(brightness)
+        {
+        }
+
+        __attribute__((always_inline)) inline bool available() const {
+            return _ptr < _end;
+        }
+
+        __attribute__((always_inline)) inline uint8_t load() {
+            uint8_t value = _order.get(_ptr++);
+            _order.next();
+            return (value * _brightness) >> 8;
+        }
+
+    private:
+        const uint8_t *_ptr;
+        const uint8_t *_end;
+        uint16_t _brightness;
+        PixelOrder<_TPixelType> _order;
+    };
+
+    // brightness masks for MaskedPixelSource
+    //
+    // a mask provides getCursor(uint32_t brightness) with the master brightness 0-65536. the cursor returns the scale
+    // 0-65536 of the next pixel with next() and is called once per pixel. the scale is applied with a single multiply
+    // per byte and the pixel data is not modified. the cursor may declare the estimated cycles of next() as
+    // kCyclesLoad, see BitBang
+
+    // master brightness only
+    class UniformBrightness {
+    public:
+        class Cursor {
+        public:
+            static constexpr uint8_t kCyclesLoad = 2;
+
+            Cursor(uint32_t brightness) : _scale(brightness) {}
+
+            __attribute__((always_inline)) inline uint32_t next() {
+                return _scale;
+            }
+
+        private:
+            uint32_t _scale;
+        };
+
+        using cursor_type = Cursor;
+
+        cursor_type getCursor(uint32_t brightness) const {
+            return cursor_type(brightness);
+        }
+    };
+
+    // 4 bit brightness for each pixel, 0 is off and 15 full brightness. 2 pixels are stored per byte
+    template<uint16_t _NumPixels>
+    class PixelBrightnessMask {
+    public:
+        static constexpr uint8_t kMaxLevel = 15;
+
+        class Cursor {
+        public:
+            static constexpr uint8_t kCyclesLoad = 10;
+
+            // the scale of all 16 levels is calculated once per frame
+            Cursor(const uint8_t *levels, uint32_t brightness) : _levels(levels), _pixel(0) {
+                for(uint8_t i = 0; i <= kMaxLevel; i++) {
+                    _scales[i] = (brightness * ((i * 4096U + kMaxLevel / 2) / kMaxLevel)) >> 12;
+                }
+            }
+
+            __attribute__((always_inline)) inline uint32_t next() {
+                uint8_t level = (_levels[_pixel >> 1] >> ((_pixel & 1) << 2)) & 0x0f;
+                _pixel++;
+                return _scales[level];
+            }
+
+        private:
+            const uint8_t *_levels;
+            uint16_t _pixel;
+            uint32_t _scales[kMaxLevel + 1];
+        };
+
+        using cursor_type = Cursor;
+
+        PixelBrightnessMask() {
+            fill(kMaxLevel);
+        }
+
+        void set(uint16_t index, uint8_t level) {
+            auto &value = _levels[index >> 1];
+            uint8_t shift = (index & 1) << 2;
+            value = (value & ~(0x0f << shift)) | ((level & 0x0f) << shift);
+        }
+
+        uint8_t get(uint16_t index) const {
+            return (_levels[index >> 1] >> ((index & 1) << 2)) & 0x0f;
+        }
+
+        void fill(uint8_t level) {
+            level &= 0x0f;
+            std::fill_n(_levels, sizeof(_levels), level | (level << 4));
+        }
+
+        void fill(uint16_t offset, uint16_t numPixels, uint8_t level) {
+            while (numPixels--) {
+                set(offset++, level);
+            }
+        }
+
+        cursor_type getCursor(uint32_t brightness) const {
+            return cursor_type(_levels, brightness);
+        }
+
+    private:
+        uint8_t _levels[(_NumPixels + 1) / 2];
+    };
+
+    // brightness 0-255 for up to _MaxSegments ranges of pixels, pixels outside the segments have full brightness
+    // the segments must not overlap and are stored ordered by offset
+    template<uint8_t _MaxSegments>
+    class SegmentBrightnessMask {
+    public:
+        struct Segment {
+            uint16_t begin;
+            uint16_t end;
+            uint8_t level;
+        };
+
+        class Cursor {
+        public:
+            // including skipping one empty segment
+            static constexpr uint8_t kCyclesLoad = 24;
+
+            // the scale is calculated once per segment
+            Cursor(const Segment *segments, uint8_t count, uint32_t brightness) :
+                _segment(segments),
+                _end(segments + count),
+                _pixel(0),
+                _brightness(brightness),
+                _scale(brightness)
+            {
+                _update();
+            }
+
+            __attribute__((always_inline)) inline uint32_t next() {
+                if (_pixel == _next) {
+                    _update();
+                }
+                _pixel++;
+                return _scale;
+            }
+
+        private:
+            // scale of _pixel and the next pixel where the scale changes
+            __attribute__((always_inline)) inline void _update() {
+                while (_segment < _end && _segment->end <= _pixel) {
+                    _segment++;
+                }
+                if (_segment < _end && _segment->begin <= _pixel) {
+                    _scale = (_brightness * blendAmount(_segment->level)) >> 8;
+                    _next = _segment->end;
+                }
+                else {
+                    _scale = _brightness;
+                    _next = _segment < _end ? _segment->begin : 0xffff;
+                }
+            }
+
+        private:
+            const Segment *_segment;
+            const Segment *_end;
+            uint16_t _pixel;
+            uint16_t _next;
+            uint32_t _brightness;
+            uint32_t _scale;
+        };
+
+        using cursor_type = Cursor;
+
+        SegmentBrightnessMask() : _count(0) {}
+
+        // set the brightness of numPixels starting at offset. an existing segment with the same offset is updated
+        // returns false if there are already _MaxSegments segments
+        bool set(uint16_t offset, uint16_t numPixels, uint8_t level) {
+            uint8_t index = 0;
+            while (index < _count && _segments[index].begin < offset) {
+                index++;
+            }
+            if (index == _count || _segments[index].begin != offset) {
+                if (_count >= _MaxSegments) {
+                    return false;
+                }
+                std::copy_backward(_segments + index, _segments + _count, _segments + _count + 1);
+                _count++;
+            }
+            _segments[index] = { offset, static_cast<uint16_t>(offset + numPixels), level };
+            return true;
+        }
+
+        void clear() {
+            _count = 0;
+        }
+
+        uint8_t size() const {
+            return _count;
+        }
+
+        cursor_type getCursor(uint32_t brightness) const {
+            return cursor_type(_segments, _count, brightness);
+        }
+
+    private:
+        Segment _segments[_MaxSegments];
+        uint8_t _count;
+    };
+
+    // pixel buffer with 16 bit master brightness and a brightness mask, see UniformBrightness
+    // each byte is scaled with (value * scale + 0x8000) >> 16, the scale of the pixel is updated by the mask once
+    // per pixel
+    template<typename _TPixelType, typename _Mask>
+    class MaskedPixelSource {
+    public:
+        using cursor_type = typename _Mask::cursor_type;
+
+        static constexpr uint8_t kCyclesLoad = BitBang::getCyclesLoad<cursor_type>() ?
+            BitBang::kCyclesLoadByte + BitBang::kCyclesLoadPixel + BitBang::getCyclesLoad<cursor_type>() + BitBang::getCyclesReOrder<_TPixelType>() : 0;
+
+        MaskedPixelSource(const uint8_t *pixels, uint16_t numBytes, const _Mask &mask, uint16_t brightness) :
+            _ptr(pixels),
+            _end(pixels + numBytes),
+            _cursor(mask.getCursor(blendAmount16(brightness))),
+            _scale(0),
+            _byte(0)
+        {
+        }
+
+        __attribute__((always_inline)) inline bool available() const {
+            return _ptr < _end;
+        }
+
+        __attribute__((always_inline)) inline uint8_t load() {
+            if (_byte == 0) {
+                _scale = _cursor.next();
+                _byte = sizeof(_TPixelType);
+            }
+            _byte--;
+            uint8_t value = _order.get(_ptr++);
+            _order.next();
+            return (value * _scale + 0x8000) >> 16;
+        }
+
+    private:
+        const uint8_t *_ptr;
+        const uint8_t *_end;
+        cursor_type _cursor;
+        uint32_t _scale;
+        uint8_t _byte;
+        PixelOrder<_TPixelType> _order;
+    };
+
+    // numBytes of zeros
+    class ZeroSource {
+    public:
+        static constexpr uint8_t kCyclesLoad = 3;
+
+        ZeroSource(uint16_t numBytes) : _numBytes(numBytes) {}
+
+        __attribute__((always_inline)) inline bool available() const {
+            return _numBytes != 0;
+        }
+
+        __attribute__((always_inline)) inline uint8_t load() {
+            _numBytes--;
+            return 0;
+        }
+
+    private:
+        uint16_t _numBytes;
+    };
+
+    // base class for data types that are sent through an output source
+    // getSource(uint16_t brightness) must return the source. brightness is 0-256
+    class SourceDataType {
+    };
+
+    // palette lookup while sending the data
+    template<typename _TPixelType, uint8_t _Bits>
+    class PaletteSource {
+    public:
+        static constexpr uint8_t kMask = (1 << _Bits) - 1;
+        // unpacking the index and the palette lookup
+        static constexpr uint8_t kCyclesLoad = BitBang::kCyclesLoadByte + BitBang::kCyclesLoadPixel + (_Bits == 8 ? 3 : 8) + BitBang::getCyclesReOrder<_TPixelType>();
+
+        PaletteSource(const uint8_t *indices, const _TPixelType *palette, uint16_t numPixels, uint16_t brightness) :
+            _indices(indices),
+            _palette(reinterpret_cast<const uint8_t *>(palette)),
+            _color(nullptr),
+            _numBytes(numPixels * sizeof(_TPixelType)),
+            _byte(0),
+            _nibble(0),
+            _brightness(brightness)
+        {
+        }
+
+        __attribute__((always_inline)) inline bool available() const {
+            return _numBytes != 0;
+        }
+
+        __attribute__((always_inline)) inline uint8_t load() {
+            if (_byte == 0) {
+                uint8_t index;
+                if __CONSTEXPR17 (_Bits == 8) {
+                    index = *_indices++;
+                }
+                else {
+                    // low nibble first
+                    index = (*_indices >> _nibble) & kMask;
+                    _nibble += _Bits;
+                    if (_nibble == 8) {
+                        _nibble = 0;
+                        _indices++;
+                    }
+                }
+                _color = _palette + index * sizeof(_TPixelType);
+            }
+            uint8_t value = _order.get(_color + _byte);
+            _order.next();
+            _byte = (_byte == sizeof(_TPixelType) - 1) ? 0 : _byte + 1;
+            _numBytes--;
+            return (value * _brightness) >> 8;
+        }
+
+    private:
+        const uint8_t *_indices;
+        const uint8_t *_palette;
+        const uint8_t *_color;
+        uint16_t _numBytes;
+        uint8_t _byte;
+        uint8_t _nibble;
+        uint16_t _brightness;
+        PixelOrder<_TPixelType> _order;
+    };
+
+    // pixel data stored as 4 or 8 bit index of a palette
+    // the colors are looked up while sending the data, 3000 pixels require 1.5KB (4 bit) or 3KB (8 bit) instead of 9KB
+    template<uint16_t _NumPixels, uint8_t _Bits = 8, typename _PixelType = GRB>
+    class IndexedPixelData : public SourceDataType
+    {
+    public:
+        static_assert(_Bits == 4 || _Bits == 8, "4 or 8 bit indices supported");
+
+        using pixel_type = _PixelType;
+        using source_type = PaletteSource<_PixelType, _Bits>;
+
+        static constexpr uint16_t kNumPixels = _NumPixels;
+        static constexpr uint16_t kPaletteSize = 1 << _Bits;
+        static constexpr uint8_t kMask = kPaletteSize - 1;
+        static constexpr uint16_t kIndexBytes = (kNumPixels * _Bits + 7) / 8;
+
+        using data_type = std::array<uint8_t, kIndexBytes>;
+        using palette_type = std::array<pixel_type, kPaletteSize>;
+
+    public:
+        IndexedPixelData() : _data{}, _palette{} {}
+
+        static constexpr uint16_t size() {
+            return kNumPixels;
+        }
+
+        static constexpr uint16_t getNumPixels() {
+            return kNumPixels;
+        }
+
+        // index data
+        uint8_t *data() {
+            return _data.data();
+        }
+
+        const uint8_t *data() const {
+            return _data.data();
+        }
+
+        palette_type &palette() {
+            return _palette;
         }
 
-        static constexpr uint16_t getNumPixels() {
-            return kNumPixels;
+        const palette_type &palette() const {
+            return _palette;
         }
 
-        static constexpr uint16_t size() {
-            return kNumPixels;
+        void setPalette(uint8_t index, const pixel_type &color) {
+            _palette[index & kMask] = color;
         }
 
-        pixel_type *data() {
-            return _data.data();
+        // rotate palette entries from first to first + count - 1 by one position
+        // changes the color of all pixels using those entries
+        void rotatePalette(uint8_t first = 0, uint16_t count = kPaletteSize) {
+            if (first >= kPaletteSize) {
+                return;
+            }
+            count = std::min<uint16_t>(count, kPaletteSize - first);
+            if (count > 1) {
+                std::rotate(&_palette[first], &_palette[first + 1], &_palette[first + count]);
+            }
         }
 
-        const pixel_type *data() const {
-            return _data.data();
+        void set(int index, uint8_t paletteIndex) {
+            if __CONSTEXPR17 (_Bits == 8) {
+                _data[index] = paletteIndex;
+            }
+            else {
+                auto &value = _data[index >> 1];
+                uint8_t shift = (index & 1) << 2;
+                value = (value & ~(kMask << shift)) | ((paletteIndex & kMask) << shift);
+            }
         }
 
-        pixel_type *begin() {
-            return data();
+        uint8_t getIndex(int index) const {
+            if __CONSTEXPR17 (_Bits == 8) {
+                return _data[index];
+            }
+            else {
+                return (_data[index >> 1] >> ((index & 1) << 2)) & kMask;
+            }
         }
 
-        const pixel_type *begin() const {
-            return data();
+        pixel_type get(int index) const {
+            return _palette[getIndex(index)];
         }
 
-        pixel_type *end() {
-            return &data()[_data.size()];
+        pixel_type operator[](int index) const {
+            return get(index);
         }
 
-        const pixel_type *end() const {
-            return data()[_data.size()];
+        void fill(uint8_t paletteIndex) {
+            paletteIndex &= kMask;
+            if __CONSTEXPR17 (_Bits == 4) {
+                paletteIndex |= paletteIndex << 4;
+            }
+            std::fill(_data.begin(), _data.end(), paletteIndex);
         }
 
-        explicit operator const pixel_type *() const {
-            return reinterpret_cast<const pixel_type *>(data());
+        // fill with the palette entry that is closest to color
+        void fill(const pixel_type &color) {
+            fill(findIndex(color));
         }
 
-        explicit operator pixel_type *() {
-            return reinterpret_cast<pixel_type *>(data());
+        // fill with black. if the palette does not contain black, the entry closest to black is set to black
+        void clear() {
+            auto index = findIndex(pixel_type(0));
+            _palette[index] = pixel_type(0);
+            fill(index);
         }
 
-        operator const uint8_t *() const {
-            return reinterpret_cast<const uint8_t *>(data());
+        void fill(uint16_t offset, uint16_t numPixels, uint8_t paletteIndex) {
+            for(uint16_t i = offset; i < offset + numPixels; i++) {
+                set(i, paletteIndex);
+            }
         }
 
-        operator uint8_t *() {
-            return reinterpret_cast<uint8_t *>(data());
+        // returns the palette index that is closest to color
+        uint8_t findIndex(const pixel_type &color) const {
+            uint8_t index = 0;
+            uint16_t minDiff = ~0;
+            for(uint16_t i = 0; i < kPaletteSize; i++) {
+                auto &entry = _palette[i];
+                uint16_t diff = abs(entry.red() - color.red()) + abs(entry.green() - color.green()) + abs(entry.blue() - color.blue());
+                if (diff < minDiff) {
+                    minDiff = diff;
+                    index = i;
+                    if (diff == 0) {
+                        break;
+                    }
+                }
+            }
+            return index;
         }
 
-        void set(int index, pixel_type color) {
-            data()[index] = color;
+        source_type getSource(uint16_t brightness) const {
+            return source_type(_data.data(), _palette.data(), kNumPixels, brightness);
         }
 
-        pixel_type get(int index) const {
-            return data()[index];
+    private:
+        data_type _data;
+        palette_type _palette;
+    };
+
+    // calls the generator for each pixel while sending the data
+    // the generator is called before the first byte of a pixel is sent and must not take longer than _Chipset::kCyclesMaxLoad
+    // the cycles of the generator are unknown and the source is not checked, see BitBang
+    template<typename _TPixelType, typename _Generator>
+    class GeneratorSource {
+    public:
+        GeneratorSource(_Generator &generator, uint16_t numPixels, uint16_t brightness) :
+            _generator(&generator),
+            _index(0),
+            _numBytes(numPixels * sizeof(_TPixelType)),
+            _byte(0),
+            _brightness(brightness)
+        {
         }
 
-        pixel_type &operator[](int index) {
-            return data()[index];
+        __attribute__((always_inline)) inline bool available() const {
+            return _numBytes != 0;
         }
 
-        pixel_type operator[](int index) const {
-            return data()[index];
+        __attribute__((always_inline)) inline uint8_t load() {
+            if (_byte == 0) {
+                _color = (*_generator)(_index++);
+            }
+            uint8_t value = _order.get(reinterpret_cast<const uint8_t *>(&_color) + _byte);
+            _order.next();
+            _byte = (_byte == sizeof(_TPixelType) - 1) ? 0 : _byte + 1;
+            _numBytes--;
+            return (value * _brightness) >> 8;
         }
 
-        // color is RGB
-        void fill(uint32_t color) {
-            std::fill(begin(), end(), pixel_type(color));
+    private:
+        _Generator *_generator;
+        uint16_t _index;
+        uint16_t _numBytes;
+        uint8_t _byte;
+        uint16_t _brightness;
+        _TPixelType _color;
+        PixelOrder<_TPixelType> _order;
+    };
+
+    // pixel data without memory. the pixels are created by the generator while sending the data
+    // _Generator must provide _PixelType operator()(uint16_t index), which should be inlined
+    template<uint16_t _NumPixels, typename _Generator, typename _PixelType = GRB>
+    class GeneratorPixelData : public SourceDataType
+    {
+    public:
+        using pixel_type = _PixelType;
+        using generator_type = _Generator;
+        using source_type = GeneratorSource<_PixelType, _Generator>;
+
+        static constexpr uint16_t kNumPixels = _NumPixels;
+
+    public:
+        template<typename ..._Args>
+        GeneratorPixelData(_Args &&...args) : _generator(std::forward<_Args &&>(args)...) {}
+
+        static constexpr uint16_t size() {
+            return kNumPixels;
         }
 
-        void fill(const pixel_type &color) {
-            std::fill(begin(), end(), color);
+        static constexpr uint16_t getNumPixels() {
+            return kNumPixels;
         }
 
-        // color is RGB
-        void fill(uint16_t numPixels, uint32_t color) {
-            std::fill_n(data(), numPixels, pixel_type(color));
+        generator_type &generator() {
+            return _generator;
         }
 
-        void fill(uint16_t numPixels, const pixel_type &color) {
-            std::fill_n(data(), numPixels, color);
+        const generator_type &generator() const {
+            return _generator;
         }
 
-        // color is RGB
-        void fill(uint16_t offset, uint16_t numPixels, uint32_t color) {
-            std::fill(data() + offset, data() + numPixels, pixel_type(color));
+        pixel_type get(int index) {
+            return _generator(index);
         }
 
-        void fill(uint16_t offset, uint16_t numPixels, const pixel_type &color) {
-            std::fill(data() + offset, data() + numPixels, color);
+        // there is no data to fill, Strip::clear() sends black pixels only
+        void fill(const pixel_type &) {
+        }
+
+        source_type getSource(uint16_t brightness) {
+            return source_type(_generator, kNumPixels, brightness);
         }
 
     private:
-        data_type _data;
+        generator_type _generator;
     };
 
     // force to clear all pixels without interruptions
@@ -860,20 +3021,169 @@ namespace NeoPixelEx {
         NeoPixelEx::Stats &getStats();
     #endif
 
-    template<uint8_t _OutputPin, uint16_t _NumPixels, typename _PixelType = GRB, typename _Chipset = TimingsWS2812, typename _DataType = PixelData<_NumPixels, _PixelType>>
+    #if NEOPIXEL_MAX_REGISTERED_STRIPS
+
+        // strips with the default output add themselves in begin() and are removed in end()
+        //
+        // the registry has a fixed size and does not allocate any memory. it is initialized statically and can be
+        // used from preinit(), a crash handler or an interrupt
+        class StripRegistry {
+        public:
+            static constexpr uint8_t kMaxEntries = NEOPIXEL_MAX_REGISTERED_STRIPS;
+
+            static_assert(kMaxEntries <= 32, "NEOPIXEL_MAX_REGISTERED_STRIPS must not exceed 32");
+
+            struct Entry {
+                const void *owner;
+                uint16_t numBytes;
+                uint16_t cyclesT0H;
+                uint16_t cyclesPeriod;
+                uint16_t nanosPeriod;
+                uint16_t resetDelay;
+                uint8_t pin;
+
+                // strips with the same timings are sent in parallel
+                bool hasSameTimings(const Entry &entry) const {
+                    return cyclesT0H == entry.cyclesT0H && cyclesPeriod == entry.cyclesPeriod;
+                }
+
+                // time to send numBytes in microseconds
+                uint32_t getFrameTime(uint16_t bytes) const {
+                    return (bytes * 8UL * nanosPeriod + 999) / 1000;
+                }
+            };
+
+            template<typename _Chipset>
+            static Entry createEntry(const void *owner, uint8_t pin, uint16_t numBytes) {
+                return { owner, numBytes, static_cast<uint16_t>(_Chipset::kCyclesT0H), static_cast<uint16_t>(_Chipset::kCyclesPeriod), static_cast<uint16_t>(_Chipset::kNanosPeriod), _Chipset::kResetDelay, pin };
+            }
+
+        public:
+            // add or update the entry of the owner, returns false if the registry is full
+            bool add(const Entry &entry);
+
+            void remove(const void *owner);
+
+            uint8_t size() const {
+                return _count;
+            }
+
+            const Entry &operator[](uint8_t index) const {
+                return _entries[index];
+            }
+
+            // call func(uint32_t entries, uint16_t numBytes, const Entry &timings) for each group of strips with the
+            // same timings. entries is a bit mask of the indices, numBytes the longest strip of the group
+            template<typename _Func>
+            void forEachGroup(_Func func) const;
+
+            // longest reset delay of all strips in microseconds
+            uint16_t getResetDelay() const;
+
+            // worst case time of blackoutAll() in microseconds
+            uint32_t getBlackoutTime() const;
+
+            #if ESP8266
+                // send black pixels to all strips with interrupts disabled
+                void blackoutAll();
+            #endif
+
+        private:
+            #if ESP8266
+                // timed loop of blackoutAll(), in IRAM like _espShow()
+                static void NEOPIXEL_ESPSHOW_FUNC_ATTR _sendZeros(uint32_t pins, bool gpio16, uint32_t numBits, uint32_t cyclesT0H, uint32_t cyclesPeriod);
+            #endif
+
+        private:
+            Entry _entries[kMaxEntries];
+            uint8_t _count;
+        };
+
+        // zero initialized, no constructor is called
+        extern StripRegistry _stripRegistry;
+
+        __attribute__((always_inline)) inline StripRegistry &getStripRegistry() {
+            return _stripRegistry;
+        }
+
+    #endif
+
+    // worst case time of blackoutAll() in microseconds if _Strips are registered
+    //
+    // static_assert(NeoPixelEx::BlackoutTime<decltype(strip1), decltype(strip2)>::kValue < 20000, "blackout takes too long");
+    template<typename ..._Strips>
+    struct BlackoutTime {
+        static constexpr uint32_t kFrames = 0;
+        static constexpr uint16_t kResetDelay = 0;
+        static constexpr uint32_t kValue = 0;
+    };
+
+    template<typename _Strip, typename ..._Strips>
+    struct BlackoutTime<_Strip, _Strips...> {
+        static constexpr uint32_t kFrames = _Strip::getFrameTime() + BlackoutTime<_Strips...>::kFrames;
+        static constexpr uint16_t kResetDelay = _Strip::chipset_type::kResetDelay > BlackoutTime<_Strips...>::kResetDelay ? _Strip::chipset_type::kResetDelay : BlackoutTime<_Strips...>::kResetDelay;
+        // reset before and after the frames
+        static constexpr uint32_t kValue = kFrames + kResetDelay * 2UL;
+    };
+
+    // output backends
+    //
+    // the default output uses bit banging on ESP8266 and RMT on ESP32. other outputs are selected with the last template
+    // argument of Strip and must provide
+    //
+    // template<uint16_t _NumBytes, typename _Chipset> using type = ...;
+    //
+    // type must provide
+    //
+    // static constexpr bool isValidPin(uint8_t pin)
+    // static constexpr bool kBrightness
+    // void begin()
+    // void end()
+    // template<typename _Source> bool show(_Source &source, Context &context)
+    //
+    // show() receives the bytes with brightness and reordering applied and updates the stats and the last display time.
+    // if kBrightness is true, the brightness is passed to setBrightness(uint8_t) before show() and the bytes are
+    // not scaled
+    struct DefaultOutput {
+        template<uint16_t _NumBytes, typename _Chipset>
+        using type = DefaultOutput;
+
+        static constexpr bool kBrightness = false;
+
+        static constexpr bool isValidPin(uint8_t) {
+            return true;
+        }
+
+        void begin() {}
+        void end() {}
+
+        template<typename _Source>
+        bool show(_Source &source, Context &context) {
+            return false;
+        }
+    };
+
+    template<uint8_t _OutputPin, uint16_t _NumPixels, typename _PixelType = GRB, typename _Chipset = TimingsWS2812, typename _DataType = PixelData<_NumPixels, _PixelType>, typename _Output = DefaultOutput, typename _ContextType = OwnContext>
     class Strip;
 
     using StaticStrip = Strip<0, 0, RGB, DefaultTimings>;
 
-    // _DataType must provide enough data for _NumPixels * sizeof(_PixelType)
-    template<uint8_t _OutputPin, uint16_t _NumPixels, typename _PixelType, typename _Chipset, typename _DataType>
-    class Strip : public PixelData<_NumPixels, _PixelType>
+    // _DataType must provide enough data for _NumPixels * sizeof(_PixelType) or be derived from SourceDataType
+    template<uint8_t _OutputPin, uint16_t _NumPixels, typename _PixelType, typename _Chipset, typename _DataType, typename _Output, typename _ContextType>
+    class Strip : protected _Output::template type<_NumPixels * sizeof(_PixelType), _Chipset>, protected _ContextType
     {
     public:
         static constexpr auto kOutputPin = _OutputPin;
         using chipset_type = _Chipset;
         using data_type = _DataType;
         using pixel_type = _PixelType;
+        using output_type = typename _Output::template type<_NumPixels * sizeof(_PixelType), _Chipset>;
+        using context_type = _ContextType;
+
+        static constexpr bool kDefaultOutput = std::is_same<output_type, DefaultOutput>::value;
+        using output_tag = std::integral_constant<bool, kDefaultOutput>;
+
+        static_assert(output_type::isValidPin(_OutputPin), "the output does not support this pin");
 
     public:
         Strip() {}
@@ -889,22 +3199,30 @@ namespace NeoPixelEx {
             return _NumPixels;
         }
 
+        static constexpr uint16_t size() {
+            return _NumPixels;
+        }
+
+        // time to send a frame in microseconds, requires a chipset with timings
+        static constexpr uint32_t getFrameTime() {
+            return (_NumPixels * sizeof(_PixelType) * 8UL * _Chipset::kNanosPeriod + 999) / 1000;
+        }
+
         __attribute__((always_inline)) inline void begin() {
-            digitalWrite(_OutputPin, LOW);
-            pinMode(_OutputPin, OUTPUT);
+            _begin(output_tag());
         }
 
         __attribute__((always_inline)) inline void end() {
             clear();
-            digitalWrite(_OutputPin, LOW);
-            pinMode(_OutputPin, INPUT);
+            _end(output_tag());
         }
 
         // clear is equal to
         // fill(0)
         // show(0)
+        // palette data is filled with black instead of the closest color
         __attribute__((always_inline)) inline void clear() {
-            fill(0);
+            _clearData(_data);
             _clear(_data.size());
         }
 
@@ -927,7 +3245,8 @@ namespace NeoPixelEx {
         }
 
         __attribute__((always_inline)) inline void fill(size_t numPixels, const pixel_type &color) {
-            std::fill_n(_data.data(), numPixels, color);
+            markDirtyRange(_data, 0, numPixels);
+            fillPixels(_data.data(), numPixels, color);
         }
 
         // color is RGB
@@ -936,11 +3255,73 @@ namespace NeoPixelEx {
         }
 
         __attribute__((always_inline)) inline void fill(uint32_t offset, size_t numPixels, const pixel_type &color) {
-            std::fill_n(_data.data() + offset, numPixels, color);
+            markDirtyRange(_data, offset, numPixels);
+            fillPixels(_data.data() + offset, numPixels, color);
         }
 
         __attribute__((always_inline)) inline void show(uint8_t brightness = 255) {
-            internalShow<_OutputPin>(reinterpret_cast<uint8_t *>(_data.data()), getNumBytes(), brightness, _context);
+            #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                if (_skipFrame(brightness, std::is_base_of<DirtyTracking, data_type>())) {
+                    return;
+                }
+                // an aborted frame is sent again by the next call
+                if (_show(brightness, std::is_base_of<SourceDataType, data_type>())) {
+                    _frameSent(brightness, std::is_base_of<DirtyTracking, data_type>());
+                }
+            #else
+                _show(brightness, std::is_base_of<SourceDataType, data_type>());
+            #endif
+        }
+
+        #if NEOPIXEL_HAVE_DIRTY_TRACKING
+            // send unchanged frames after interval milliseconds, 0 to disable
+            void setKeepAliveInterval(uint16_t interval) {
+                _keepAliveInterval = interval;
+            }
+        #endif
+
+        // display the data of an output source
+        // the source must provide getNumPixels() pixels
+        template<typename _Source>
+        __attribute__((always_inline)) inline void showSource(const _Source &source) {
+            _invalidateFrame();
+            _outputBrightness(255);
+            _showSource(source);
+        }
+
+        // display getNumPixels() pixels from a different buffer with the output and brightness of the strip, for
+        // example a frame of an OutputTask. the data of the strip is not used
+        __attribute__((always_inline)) inline void showPixels(const pixel_type *pixels, uint8_t brightness = 255) {
+            _invalidateFrame();
+            _showPixels(pixels, _outputBrightness(brightness), output_tag());
+        }
+
+        // display the blended pixels of from and to without storing them
+        // from and to must provide getNumPixels() pixels of pixel_type
+        template<typename _Ta, typename _Tb>
+        __attribute__((always_inline)) inline void showBlend(const _Ta &from, const _Tb &to, uint8_t amount, uint8_t brightness = 255) {
+            const pixel_type *fromPixels = from.data();
+            const pixel_type *toPixels = to.data();
+            _invalidateFrame();
+            brightness = _outputBrightness(brightness);
+            BlendSource<_PixelType> source(reinterpret_cast<const uint8_t *>(fromPixels), reinterpret_cast<const uint8_t *>(toPixels), getNumBytes(), amount, brightness ? brightness + 1 : 0);
+            _showSource(source);
+        }
+
+        // display the pixels with a 16 bit brightness 0-65535
+        __attribute__((always_inline)) inline void show16(uint16_t brightness) {
+            showMasked(UniformBrightness(), brightness);
+        }
+
+        // display the pixels with a 16 bit master brightness and the brightness of each pixel from mask, see
+        // PixelBrightnessMask and SegmentBrightnessMask. the pixel data is not modified
+        template<typename _Mask>
+        __attribute__((always_inline)) inline void showMasked(const _Mask &mask, uint16_t brightness = 0xffff) {
+            static_assert(!std::is_base_of<SourceDataType, data_type>::value, "the data type must provide the pixels");
+            // the frame differs from show() with any 8 bit brightness
+            _invalidateFrame();
+            _outputBrightness(255);
+            _showSource(MaskedPixelSource<_PixelType, _Mask>(reinterpret_cast<const uint8_t *>(_data.data()), getNumBytes(), mask, brightness));
         }
 
         __attribute__((always_inline)) inline pixel_type &operator[](int index) {
@@ -951,16 +3332,23 @@ namespace NeoPixelEx {
             return data()[index];
         }
 
+        __attribute__((always_inline)) inline void set(int index, pixel_type color) {
+            data()[index] = color;
+        }
+
+        __attribute__((always_inline)) inline pixel_type get(int index) const {
+            return data()[index];
+        }
+
         // this method allows to clear any number of pixels
         // it does not change the actual data
         __attribute__((always_inline)) void _clear(uint16_t numPixels)
         {
-            uint8_t buf[1];
-            internalShow<_OutputPin>(buf, getNumBytes(), 0, _context);
+            _clear(numPixels, output_tag());
         }
 
         __attribute__((always_inline)) inline bool canShow() const {
-            return (micros() - _context.getLastDisplayTime() > _Chipset::kMinDisplayPeriod);
+            return (micros() - _ContextType::getStripContext().getLastDisplayTime() > _Chipset::kMinDisplayPeriod);
         }
 
         __attribute__((always_inline)) inline data_type &data() {
@@ -992,13 +3380,18 @@ namespace NeoPixelEx {
         #if NEOPIXEL_HAVE_STATS
             __attribute__((always_inline)) inline Stats &getStats()
             {
-                return _context.getStats();
+                return getContext().getStats();
             }
         #endif
 
         __attribute__((always_inline)) inline Context &getContext()
         {
-            return _context;
+            return _ContextType::getStripContext();
+        }
+
+        __attribute__((always_inline)) inline output_type &getOutput()
+        {
+            return *this;
         }
 
     protected:
@@ -1114,6 +3507,9 @@ namespace NeoPixelEx {
         template<uint8_t _Pin, typename _TChipset, typename _TPixelType>
         static bool NEOPIXEL_ESPSHOW_FUNC_ATTR _espShow(uint16_t brightness, const uint8_t *p, const uint8_t *end, uint32_t time0, uint32_t time1, uint32_t &period, uint32_t wait, uint32_t minWaitPeriod)
         {
+            #if NEOPIXEL_CHECK_CYCLE_BUDGET
+                static_assert(_TChipset::meetsTiming(BitBang::getFeatures(_Pin, _TPixelType::kReOrder)), "the bit banging loop cannot meet the timings of the chipset with this pin, pixel type and F_CPU");
+            #endif
             uint32_t startTime = 0;
             uint32_t c, t;
             uint8_t mask = 0x80;
@@ -1128,7 +3524,104 @@ namespace NeoPixelEx {
             pix = applyBrightness(pix, brightness);
 
             #if NEOPIXEL_USE_PRECACHING
-                PRECACHE_START(NeoPixel_espShow);
+                PRECACHE_START(NeoPixel_espShow);
+            #endif
+
+            for (;;) {
+                t = (pix & mask) ? time1 : time0;
+
+                #if NEOPIXEL_ALLOW_INTERRUPTS
+                    // check first if we have a timeout
+                    if (((c = _getCycleCount()) - startTime) <= period + static_cast<uint8_t>(microsecondsToClockCycles(0.6))) {
+                #endif
+                        while (((c = _getCycleCount()) - startTime) < period) {
+                            // wait for bit start
+                        }
+                #if NEOPIXEL_ALLOW_INTERRUPTS
+                    }
+                    else if (startTime) {
+                        // set period to 0 to remove the wait time and marker for timeout
+                        period = 0;
+                        break;
+                    }
+                #endif
+
+                gpio_set_level_high<_Pin>();
+                startTime = c ? c : 1; // save start time, zero is reserved
+
+                if (!(mask >>= 1)) {
+                    if (p < end) {
+                        mask = 0x80; // load next byte indicator
+                        if __CONSTEXPR17 (_TPixelType::kReOrder) {
+                            // offset of R/G/B
+                            if (ofs == sizeof(_TPixelType) - 1) {
+                                ofs = 0;
+                            }
+                            else {
+                                ofs++;
+                            }
+                        }
+                    }
+                    // else {
+                    //     mask = 0; // end of frame indicator
+                    // }
+                }
+
+                while (((c = _getCycleCount()) - startTime) < t) {
+                    // t0h/t1h wait
+                }
+                gpio_set_level_low<_Pin>();
+
+                #if NEOPIXEL_ALLOW_INTERRUPTS
+                    // check if we had a timeout during the TxH phase
+                    if ((c - startTime) > t + static_cast<uint8_t>(microsecondsToClockCycles(0.3))) {
+                        #if NEOPIXEL_DEBUG
+                            Context::validate(nullptr).getDebugContext().togglePin2();
+                        #endif
+                        period = 0;
+                        break;
+                    }
+                #endif
+
+                if (mask == 0) { // end of frame
+                    break;
+                }
+                if (mask == 0x80) {
+                    if __CONSTEXPR17 (_TPixelType::kReOrder) {
+                        pix = loadPixel<typename _TPixelType::OrderType>(p, brightness, ofs);
+                    }
+                    else {
+                        pix = loadPixel(p, brightness);
+                    }
+                    pix = applyBrightness(pix, brightness);
+                }
+
+            }
+            while ((_getCycleCount() - startTime) < period) {
+                // t0l/t1l wait
+            }
+
+            return period != 0;
+            #if NEOPIXEL_USE_PRECACHING
+                PRECACHE_END(NeoPixel_espShow);
+            #endif
+        }
+
+        // same as _espShow() but the data is read from an output source
+        template<uint8_t _Pin, typename _TChipset, typename _Source>
+        static bool NEOPIXEL_ESPSHOW_FUNC_ATTR _espShowSource(_Source &source, uint16_t, uint32_t time0, uint32_t time1, uint32_t &period)
+        {
+            #if NEOPIXEL_CHECK_CYCLE_BUDGET
+                // sources without kCyclesLoad are not checked
+                static_assert(BitBang::getCyclesLoad<_Source>() == 0 || _TChipset::meetsTimingSource(BitBang::getFeatures(_Pin, false), BitBang::getCyclesLoad<_Source>()), "the bit banging loop cannot meet the timings of the chipset with this pin, output source and F_CPU");
+            #endif
+            uint32_t startTime = 0;
+            uint32_t c, t;
+            uint8_t mask = 0x80;
+            uint8_t pix = source.load();
+
+            #if NEOPIXEL_USE_PRECACHING
+                PRECACHE_START(NeoPixel_espShowSource);
             #endif
 
             for (;;) {
@@ -1144,7 +3637,6 @@ namespace NeoPixelEx {
                 #if NEOPIXEL_ALLOW_INTERRUPTS
                     }
                     else if (startTime) {
-                        // set period to 0 to remove the wait time and marker for timeout
                         period = 0;
                         break;
                     }
@@ -1154,21 +3646,9 @@ namespace NeoPixelEx {
                 startTime = c ? c : 1; // save start time, zero is reserved
 
                 if (!(mask >>= 1)) {
-                    if (p < end) {
+                    if (source.available()) {
                         mask = 0x80; // load next byte indicator
-                        if __CONSTEXPR17 (_TPixelType::kReOrder) {
-                            // offset of R/G/B
-                            if (ofs == sizeof(_TPixelType) - 1) {
-                                ofs = 0;
-                            }
-                            else {
-                                ofs++;
-                            }
-                        }
                     }
-                    // else {
-                    //     mask = 0; // end of frame indicator
-                    // }
                 }
 
                 while (((c = _getCycleCount()) - startTime) < t) {
@@ -1191,15 +3671,8 @@ namespace NeoPixelEx {
                     break;
                 }
                 if (mask == 0x80) {
-                    if __CONSTEXPR17 (_TPixelType::kReOrder) {
-                        pix = loadPixel<typename _TPixelType::OrderType>(p, brightness, ofs);
-                    }
-                    else {
-                        pix = loadPixel(p, brightness);
-                    }
-                    pix = applyBrightness(pix, brightness);
+                    pix = source.load();
                 }
-
             }
             while ((_getCycleCount() - startTime) < period) {
                 // t0l/t1l wait
@@ -1207,7 +3680,7 @@ namespace NeoPixelEx {
 
             return period != 0;
             #if NEOPIXEL_USE_PRECACHING
-                PRECACHE_END(NeoPixel_espShow);
+                PRECACHE_END(NeoPixel_espShowSource);
             #endif
         }
 
@@ -1309,9 +3782,63 @@ namespace NeoPixelEx {
             *item_num = numBits;
         }
 
+        template<typename _Source>
+        static void IRAM_ATTR source_rmt_adapter(const void *src, rmt_item32_t *dest, size_t src_size, size_t wanted_num, size_t *translated_size, size_t *item_num)
+        {
+            RTM_Adapter_Data_t *data = nullptr;
+            // find meta data by checking if the src pointer fits into the range
+            for (size_t i = 0; i < kMaxRmtChannels; i++) {
+                auto &channel = rmtChannelsInUse[i];
+                if (channel.inUse && src >= channel.begin && src < channel.end) {
+                    data = &channel;
+                    break;
+                }
+            }
+            if (data == nullptr || data->source == nullptr || dest == NULL) {
+                *translated_size = 0;
+                *item_num = 0;
+                return;
+            }
+            auto &source = *reinterpret_cast<_Source *>(data->source);
+            const auto bit0 = data->bit0.val;
+            const auto bit1 = data->bit1.val;
+            // the source is read sequentially, src is only used to find the channel
+            size_t numBytes = 0;
+            rmt_item32_t *pDest = dest;
+            while (numBytes < src_size && (numBytes + 1) * 8 <= wanted_num && source.available()) {
+                uint8_t pix = source.load();
+                for(uint8_t mask = 0x80; mask; mask >>= 1) {
+                    pDest->val = (pix & mask) ? bit1 : bit0;
+                    pDest++;
+                }
+                numBytes++;
+            }
+            *translated_size = numBytes;
+            *item_num = numBytes * 8;
+        }
+
         // extra function to keep the IRAM usage low
         template<uint8_t _Pin, typename _TChipset, typename _TPixelType>
         static bool NEOPIXEL_ESPSHOW_FUNC_ATTR _espShow(uint16_t brightness, const uint8_t *p, const uint8_t *end, uint32_t time0, uint32_t time1, uint32_t &period, uint32_t wait, uint32_t minWaitPeriod)
+        {
+            if (p == nullptr) {
+                p++;
+                end++;
+                return _rmtShow<_Pin, _TChipset>(brightness, p, end, clear_pixels_rmt_adapter<_TPixelType>, nullptr);
+            }
+            return _rmtShow<_Pin, _TChipset>(brightness, p, end, copy_pixels_rmt_adapter<_TPixelType>, nullptr);
+        }
+
+        // the source is used as src for rmt_write_sample() to find the channel and is not accessed directly
+        template<uint8_t _Pin, typename _TChipset, typename _Source>
+        static bool NEOPIXEL_ESPSHOW_FUNC_ATTR _espShowSource(_Source &source, uint16_t numBytes, uint32_t time0, uint32_t time1, uint32_t &period)
+        {
+            auto p = reinterpret_cast<const uint8_t *>(&source);
+            return _rmtShow<_Pin, _TChipset>(0, p, p + numBytes, source_rmt_adapter<_Source>, &source);
+        }
+
+        template<uint8_t _Pin, typename _TChipset>
+        static bool _rmtShow(uint16_t brightness, const uint8_t *p, const uint8_t *end, sample_to_rmt_t translator, void *source)
         {
             RTM_Adapter_Data_t *channelData = nullptr;
             auto channel = rmt_channel_t(kMaxRmtChannels);
@@ -1335,7 +3862,7 @@ namespace NeoPixelEx {
                 rmt_config_t config = {
                     .rmt_mode = RMT_MODE_TX,
                     .channel = channel,
-                    .gpio_num = gpio_num_t(pin),
+                    .gpio_num = gpio_num_t(_Pin),
                     .clk_div = 2,
                     .mem_block_num = 1,
                     .tx_config = {
@@ -1371,14 +3898,7 @@ namespace NeoPixelEx {
             #endif
 
             // Initialize automatic timing translator
-            if (p == nullptr) {
-                p++;
-                end++;
-                rmt_translator_init(config.channel, clear_pixels_rmt_adapter<_TPixelType>);
-            }
-            else {
-                rmt_translator_init(config.channel, copy_pixels_rmt_adapter<_TPixelType>);
-            }
+            rmt_translator_init(config.channel, translator);
 
             // NS to tick converter
             float ratio = (float)counter_clk_hz / 1e9;
@@ -1388,6 +3908,7 @@ namespace NeoPixelEx {
             channelData->begin = (uint8_t *)p;
             channelData->end = (uint8_t *)end;
             channelData->brightness = brightness;
+            channelData->source = source;
 
             rmt_write_sample(config.channel, p, (size_t)(end - p), true);
             rmt_wait_tx_done(config.channel, pdMS_TO_TICKS(100));
@@ -1439,6 +3960,165 @@ namespace NeoPixelEx {
             return result;
         }
 
+        #if NEOPIXEL_HAVE_DIRTY_TRACKING
+
+            bool _skipFrame(uint8_t brightness, std::true_type) {
+                if (!_data.isDirty() && brightness == _lastBrightness && (_keepAliveInterval == 0 || micros() - getContext().getLastDisplayTime() < _keepAliveInterval * 1000UL)) {
+                    #if NEOPIXEL_HAVE_STATS
+                        getContext().getStats().incrementSkipped();
+                    #endif
+                    return true;
+                }
+                return false;
+            }
+
+            // the data type does not track changes
+            constexpr bool _skipFrame(uint8_t, std::false_type) const {
+                return false;
+            }
+
+            // the output reported success, the frame on the LEDs is equal to the pixel data
+            void _frameSent(uint8_t brightness, std::true_type) {
+                _data.clearDirty();
+                _lastBrightness = brightness;
+            }
+
+            void _frameSent(uint8_t, std::false_type) {
+            }
+
+        #endif
+
+        // show() must send the pixel data after anything else has been sent
+        __attribute__((always_inline)) inline void _invalidateFrame() {
+            markDirtyRange(_data, 0, _NumPixels);
+        }
+
+        // returns false if the frame was aborted
+        __attribute__((always_inline)) inline bool _show(uint8_t brightness, std::false_type) {
+            return _showPixels(_data.data(), _outputBrightness(brightness), output_tag());
+        }
+
+        __attribute__((always_inline)) inline bool _show(uint8_t brightness, std::true_type) {
+            brightness = _outputBrightness(brightness);
+            return _showSource(_data.getSource(brightness ? brightness + 1 : 0));
+        }
+
+        template<typename _Source>
+        __attribute__((always_inline)) inline bool _showSource(_Source source) {
+            return _showSource(source, output_tag());
+        }
+
+        // the output type is selected with tag dispatch. the bit banging code must not be instantiated for other
+        // outputs, the chipset might not provide any timings
+
+        __attribute__((always_inline)) inline void _begin(std::true_type) {
+            digitalWrite(_OutputPin, LOW);
+            pinMode(_OutputPin, OUTPUT);
+            #if NEOPIXEL_MAX_REGISTERED_STRIPS
+                _stripRegistry.add(StripRegistry::createEntry<_Chipset>(this, _OutputPin, getNumBytes()));
+            #endif
+        }
+
+        __attribute__((always_inline)) inline void _begin(std::false_type) {
+            output_type::begin();
+        }
+
+        __attribute__((always_inline)) inline void _end(std::true_type) {
+            #if NEOPIXEL_MAX_REGISTERED_STRIPS
+                _stripRegistry.remove(this);
+            #endif
+            digitalWrite(_OutputPin, LOW);
+            pinMode(_OutputPin, INPUT);
+        }
+
+        __attribute__((always_inline)) inline void _end(std::false_type) {
+            output_type::end();
+        }
+
+        template<typename _Ta>
+        __attribute__((always_inline)) inline void _clearData(_Ta &data) {
+            data.fill(pixel_type(0));
+        }
+
+        template<uint16_t _Size, uint8_t _Bits, typename _Ta>
+        __attribute__((always_inline)) inline void _clearData(IndexedPixelData<_Size, _Bits, _Ta> &data) {
+            data.clear();
+        }
+
+        __attribute__((always_inline)) inline void _clear(uint16_t, std::true_type) {
+            uint8_t buf[1];
+            internalShow<_OutputPin>(buf, getNumBytes(), 0, getContext());
+        }
+
+        __attribute__((always_inline)) inline void _clear(uint16_t, std::false_type) {
+            _outputBrightness(255);
+            _showSource(ZeroSource(getNumBytes()));
+        }
+
+        __attribute__((always_inline)) inline bool _showPixels(const pixel_type *pixels, uint8_t brightness, std::true_type) {
+            return internalShow<_OutputPin>(reinterpret_cast<const uint8_t *>(pixels), getNumBytes(), brightness, getContext());
+        }
+
+        __attribute__((always_inline)) inline bool _showPixels(const pixel_type *pixels, uint8_t brightness, std::false_type) {
+            return _showSource(PixelSource<_PixelType>(reinterpret_cast<const uint8_t *>(pixels), getNumBytes(), brightness ? brightness + 1 : 0));
+        }
+
+        template<typename _Source>
+        __attribute__((always_inline)) inline bool _showSource(_Source &source, std::true_type) {
+            return externalShowSource<_OutputPin, _Chipset>(source, getNumBytes(), getContext());
+        }
+
+        template<typename _Source>
+        __attribute__((always_inline)) inline bool _showSource(_Source &source, std::false_type) {
+            return output_type::show(source, getContext());
+        }
+
+        // outputs with kBrightness apply the brightness themselves and receive full scale data
+        // returns the brightness for the output source
+        __attribute__((always_inline)) inline uint8_t _outputBrightness(uint8_t brightness) {
+            return _outputBrightness(brightness, std::integral_constant<bool, output_type::kBrightness>());
+        }
+
+        __attribute__((always_inline)) inline uint8_t _outputBrightness(uint8_t brightness, std::true_type) {
+            output_type::setBrightness(brightness);
+            return 255;
+        }
+
+        __attribute__((always_inline)) inline uint8_t _outputBrightness(uint8_t brightness, std::false_type) {
+            return brightness;
+        }
+
+        template<uint8_t _Pin, typename _TChipset, typename _Source>
+        static bool espShowSource(_Source source, uint16_t numBytes, void *contextPtr)
+        {
+            auto &context = *reinterpret_cast<NeoPixelEx::Context *>(contextPtr);
+
+            context.waitRefreshTime(_TChipset::getMinDisplayPeriod());
+
+            uint32_t period = _TChipset::getCyclesPeriod();
+            #if !NEOPIXEL_ALLOW_INTERRUPTS
+                ets_intr_lock();
+            #endif
+
+            #if NEOPIXEL_DEBUG
+                context.getDebugContext().togglePin();
+            #endif
+
+            bool result = _espShowSource<_Pin, _TChipset, _Source>(source, numBytes, _TChipset::getCyclesT0H(), _TChipset::getCyclesT1H(), period);
+
+            #if NEOPIXEL_HAVE_STATS
+                context.getStats().increment(result);
+            #endif
+
+            #if !NEOPIXEL_ALLOW_INTERRUPTS
+                ets_intr_unlock();
+            #endif
+
+            context.setLastDisplayTime(micros());
+
+            return result;
+        }
+
         template<uint8_t _Pin>
         bool internalShow(const uint8_t *pixels, uint16_t numBytes, uint8_t brightness, Context &context)
         {
@@ -1463,16 +4143,49 @@ namespace NeoPixelEx {
                     result = espShow<_Pin, _Chipset2, _PixelType2>(brightness, p, end, &context);
             #if NEOPIXEL_INTERRUPT_RETRY_COUNT > 0
                 }
-                while(result != true && retries-- > 0);
+                while(result != true && retries-- > 0 && _countRetry(context));
+            #endif
+
+            return result;
+        }
+
+        // send numBytes from an output source
+        template<uint8_t _Pin, typename _Chipset2, typename _Source>
+        static inline bool externalShowSource(const _Source &source, uint16_t numBytes, Context &context)
+        {
+            if (!numBytes) {
+                return true;
+            }
+            bool result = false;
+
+            #if NEOPIXEL_INTERRUPT_RETRY_COUNT > 0
+                uint8_t retries = NEOPIXEL_INTERRUPT_RETRY_COUNT;
+                do {
+            #endif
+                    result = espShowSource<_Pin, _Chipset2, _Source>(source, numBytes, &context);
+            #if NEOPIXEL_INTERRUPT_RETRY_COUNT > 0
+                }
+                while(result != true && retries-- > 0 && _countRetry(context));
             #endif
 
             return result;
         }
 
+    private:
+        __attribute__((always_inline)) static inline bool _countRetry(Context &context)
+        {
+            #if NEOPIXEL_HAVE_STATS
+                context.getStats().incrementRetries();
+            #endif
+            return true;
+        }
 
     private:
         data_type _data;
-        Context _context;
+        #if NEOPIXEL_HAVE_DIRTY_TRACKING
+            uint16_t _keepAliveInterval = NEOPIXEL_KEEP_ALIVE_INTERVAL;
+            uint8_t _lastBrightness = 0;
+        #endif
     };
 
     extern Context _globalContext;
@@ -1484,6 +4197,18 @@ namespace NeoPixelEx {
             return _globalContext.getStats();
         }
 
+        // sum of the stats of all strips passed as arguments
+        //
+        // auto stats = NeoPixelEx::aggregateStats(strip1, strip2, strip3);
+        template<typename ..._Strips>
+        StatsSnapshot aggregateStats(_Strips &...strips)
+        {
+            StatsSnapshot result;
+            int dummy[] = { 0, (result += strips.getStats().getSnapshot(), 0)... };
+            (void)dummy;
+            return result;
+        }
+
     #endif
 
     inline Context &Context::validate(void *contextPtr)
@@ -1521,13 +4246,196 @@ namespace NeoPixelEx {
         #endif
     }
 
+    #if NEOPIXEL_MAX_REGISTERED_STRIPS
+
+        inline bool StripRegistry::add(const Entry &entry)
+        {
+            #if ESP8266
+                ets_intr_lock();
+            #endif
+            bool result = true;
+            uint8_t index = 0;
+            while (index < _count && _entries[index].owner != entry.owner) {
+                index++;
+            }
+            if (index < _count) {
+                _entries[index] = entry;
+            }
+            else if (_count < kMaxEntries) {
+                _entries[_count++] = entry;
+            }
+            else {
+                result = false;
+            }
+            #if ESP8266
+                ets_intr_unlock();
+            #endif
+            return result;
+        }
+
+        inline void StripRegistry::remove(const void *owner)
+        {
+            #if ESP8266
+                ets_intr_lock();
+            #endif
+            for(uint8_t i = 0; i < _count; i++) {
+                if (_entries[i].owner == owner) {
+                    _entries[i] = _entries[--_count];
+                    break;
+                }
+            }
+            #if ESP8266
+                ets_intr_unlock();
+            #endif
+        }
+
+        template<typename _Func>
+        inline void StripRegistry::forEachGroup(_Func func) const
+        {
+            uint32_t done = 0;
+            for(uint8_t i = 0; i < _count; i++) {
+                if (done & (1UL << i)) {
+                    continue;
+                }
+                uint32_t group = 0;
+                uint16_t numBytes = 0;
+                for(uint8_t j = i; j < _count; j++) {
+                    if (_entries[j].hasSameTimings(_entries[i])) {
+                        group |= 1UL << j;
+                        numBytes = std::max(numBytes, _entries[j].numBytes);
+                    }
+                }
+                done |= group;
+                func(group, numBytes, _entries[i]);
+            }
+        }
+
+        inline uint16_t StripRegistry::getResetDelay() const
+        {
+            uint16_t resetDelay = 0;
+            for(uint8_t i = 0; i < _count; i++) {
+                resetDelay = std::max(resetDelay, _entries[i].resetDelay);
+            }
+            return resetDelay;
+        }
+
+        inline uint32_t StripRegistry::getBlackoutTime() const
+        {
+            uint32_t time = getResetDelay() * 2UL;
+            forEachGroup([&time](uint32_t, uint16_t numBytes, const Entry &timings) {
+                time += timings.getFrameTime(numBytes);
+            });
+            return time;
+        }
+
+        #if ESP8266
+
+            // all strips of a group get the same number of black pixels. the time is limited by the longest strip
+            // of each group, pixels after the end of a strip are ignored
+            inline void StripRegistry::blackoutAll()
+            {
+                ets_intr_lock();
+
+                // pins low for the reset time to end any frame that has been interrupted
+                uint32_t mask = 0;
+                for(uint8_t i = 0; i < _count; i++) {
+                    if (_entries[i].pin == 16) {
+                        GP16O = NEOPIXEL_INVERT_OUTPUT;
+                    }
+                    else {
+                        mask |= 1UL << _entries[i].pin;
+                    }
+                }
+                #if NEOPIXEL_INVERT_OUTPUT
+                    GPOS = mask;
+                #else
+                    GPOC = mask;
+                #endif
+                delayMicroseconds(getResetDelay());
+
+                forEachGroup([this](uint32_t group, uint16_t numBytes, const Entry &timings) {
+                    uint32_t pins = 0;
+                    bool gpio16 = false;
+                    for(uint8_t i = 0; i < _count; i++) {
+                        if (group & (1UL << i)) {
+                            if (_entries[i].pin == 16) {
+                                gpio16 = true;
+                            }
+                            else {
+                                pins |= 1UL << _entries[i].pin;
+                            }
+                        }
+                    }
+                    _sendZeros(pins, gpio16, numBytes * 8UL, timings.cyclesT0H, timings.cyclesPeriod);
+                });
+
+                delayMicroseconds(getResetDelay());
+                ets_intr_unlock();
+            }
+
+            inline void NEOPIXEL_ESPSHOW_FUNC_ATTR StripRegistry::_sendZeros(uint32_t pins, bool gpio16, uint32_t numBits, uint32_t cyclesT0H, uint32_t cyclesPeriod)
+            {
+                #if NEOPIXEL_USE_PRECACHING
+                    PRECACHE_START(NeoPixel_sendZeros);
+                #endif
+
+                uint32_t start;
+                __asm__ __volatile__("rsr %0,ccount" : "=a"(start));
+                start -= cyclesPeriod;
+                while (numBits--) {
+                    uint32_t c;
+                    do {
+                        __asm__ __volatile__("rsr %0,ccount" : "=a"(c));
+                    } while (c - start < cyclesPeriod);
+                    start = c;
+                    #if NEOPIXEL_INVERT_OUTPUT
+                        GPOC = pins;
+                    #else
+                        GPOS = pins;
+                    #endif
+                    if (gpio16) {
+                        GP16O = !NEOPIXEL_INVERT_OUTPUT;
+                    }
+                    do {
+                        __asm__ __volatile__("rsr %0,ccount" : "=a"(c));
+                    } while (c - start < cyclesT0H);
+                    #if NEOPIXEL_INVERT_OUTPUT
+                        GPOS = pins;
+                    #else
+                        GPOC = pins;
+                    #endif
+                    if (gpio16) {
+                        GP16O = NEOPIXEL_INVERT_OUTPUT;
+                    }
+                }
+
+                #if NEOPIXEL_USE_PRECACHING
+                    PRECACHE_END(NeoPixel_sendZeros);
+                #endif
+            }
+
+        #endif
+
+    #endif
+
+    #if NEOPIXEL_MAX_REGISTERED_STRIPS && ESP8266
+
+        // send black pixels to all strips that have been registered by Strip::begin() within
+        // getStripRegistry().getBlackoutTime() microseconds
+        inline void blackoutAll()
+        {
+            _stripRegistry.blackoutAll();
+        }
+
+    #endif
+
 }
 
 extern "C" {
 
     inline void NeoPixel_fillColorGRB(NeoPixelEx::RGB *pixels, uint16_t numBytes, const NeoPixelEx::RGB &color)
     {
-        std::fill_n(pixels, numBytes, color);
+        NeoPixelEx::fillPixels(pixels, numBytes, color);
     }
 
     inline void NeoPixel_fillColor(uint8_t *pixels, uint16_t numBytes, uint32_t RGBcolor)
@@ -0,0 +1,302 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+namespace NeoPixelEx {
+
+    // run length encoded animations stored in PROGMEM
+    //
+    // header, 8 byte
+    //
+    // uint16_t numPixels
+    // uint16_t numFrames
+    // uint16_t frame delay in milliseconds
+    // uint16_t flags
+    //
+    // followed by the frames. each frame is a list of commands terminated by kEndOfFrame
+    // the first byte of a command contains the type (bit 6-7) and the number of pixels - 1 (bit 0-5)
+    //
+    // kSkip        keep the current color
+    // kRun         set pixels to the RGB color stored in the next 3 byte
+    // kLiteral     3 byte RGB color for each pixel
+    // kEndOfFrame  remaining pixels are not changed
+    //
+    // the data must be 4 byte aligned and padded to a multiple of 4 byte
+    // scripts/rle_encode.py creates the data from raw RGB frames
+    namespace RLE {
+
+        static constexpr uint8_t kSkip = 0x00;
+        static constexpr uint8_t kRun = 0x40;
+        static constexpr uint8_t kLiteral = 0x80;
+        static constexpr uint8_t kControl = 0xc0;
+        static constexpr uint8_t kEndOfFrame = kControl;
+        static constexpr uint8_t kTypeMask = 0xc0;
+        static constexpr uint8_t kCountMask = 0x3f;
+
+        static constexpr uint8_t kHeaderSize = 8;
+
+        // all frames are encoded without kSkip and can be sent directly without a pixel buffer
+        static constexpr uint16_t kFlagNoDelta = 0x0001;
+
+        // reads bytes from flash using aligned 32 bit reads
+        class FlashReader {
+        public:
+            FlashReader(const uint8_t *ptr) :
+                _ptr(reinterpret_cast<const uint8_t *>(reinterpret_cast<uintptr_t>(ptr) & ~3)),
+                _word(0),
+                _available(0)
+            {
+                // discard bytes before ptr
+                for(uint8_t i = reinterpret_cast<uintptr_t>(ptr) & 3; i; i--) {
+                    read();
+                }
+            }
+
+            __attribute__((always_inline)) inline uint8_t read() {
+                if (_available == 0) {
+                    _word = pgm_read_dword(_ptr);
+                    _ptr += 4;
+                    _available = 4;
+                }
+                uint8_t value = static_cast<uint8_t>(_word);
+                _word >>= 8;
+                _available--;
+                return value;
+            }
+
+            template<typename _PixelType>
+            __attribute__((always_inline)) inline _PixelType readColor() {
+                uint8_t red = read();
+                uint8_t green = read();
+                return _PixelType(red, green, read());
+            }
+
+        private:
+            const uint8_t *_ptr;
+            uint32_t _word;
+            uint8_t _available;
+        };
+
+        // expands the commands of a single frame while sending the data
+        // kSkip and the pixels after kEndOfFrame are sent as black
+        template<typename _PixelType>
+        class Source {
+        public:
+            Source(const FlashReader &reader, uint16_t numPixels, uint16_t brightness) :
+                _reader(reader),
+                _numBytes(numPixels * sizeof(_PixelType)),
+                _count(0),
+                _type(kRun),
+                _byte(0),
+                _brightness(brightness)
+            {
+            }
+
+            __attribute__((always_inline)) inline bool available() const {
+                return _numBytes != 0;
+            }
+
+            __attribute__((always_inline)) inline uint8_t load() {
+                if (_byte == 0) {
+                    _nextPixel();
+                }
+                uint8_t value = _order.get(reinterpret_cast<const uint8_t *>(&_color) + _byte);
+                _order.next();
+                _byte = (_byte == sizeof(_PixelType) - 1) ? 0 : _byte + 1;
+                _numBytes--;
+                return (value * _brightness) >> 8;
+            }
+
+        private:
+            __attribute__((always_inline)) inline void _nextPixel() {
+                if (_count == 0) {
+                    uint8_t command = _reader.read();
+                    _type = command & kTypeMask;
+                    if (_type == kControl) {
+                        // end of frame, do not read any further
+                        _type = kRun;
+                        _count = ~0;
+                        _color = _PixelType();
+                    }
+                    else {
+                        _count = (command & kCountMask) + 1;
+                        if (_type == kRun) {
+                            _color = _reader.readColor<_PixelType>();
+                        }
+                        else if (_type == kSkip) {
+                            _color = _PixelType();
+                        }
+                    }
+                }
+                if (_type == kLiteral) {
+                    _color = _reader.readColor<_PixelType>();
+                }
+                _count--;
+            }
+
+        private:
+            FlashReader _reader;
+            uint16_t _numBytes;
+            uint16_t _count;
+            uint8_t _type;
+            uint8_t _byte;
+            uint16_t _brightness;
+            _PixelType _color;
+            PixelOrder<_PixelType> _order;
+        };
+
+    }
+
+    // plays an RLE animation from PROGMEM
+    // the memory usage does not depend on the size of the animation
+    // the header is read with aligned 32 bit reads like the frames
+    template<typename _PixelType = GRB>
+    class RLEPlayer {
+    public:
+        using source_type = RLE::Source<_PixelType>;
+
+        RLEPlayer(const void *animation) :
+            _animation(reinterpret_cast<const uint8_t *>(animation)),
+            _numPixels(static_cast<uint16_t>(pgm_read_dword(_animation))),
+            _numFrames(pgm_read_dword(_animation) >> 16),
+            _frameDelay(static_cast<uint16_t>(pgm_read_dword(_animation + 4))),
+            _flags(pgm_read_dword(_animation + 4) >> 16),
+            _reader(_animation + RLE::kHeaderSize),
+            _frame(0)
+        {
+        }
+
+        uint16_t getNumPixels() const {
+            return _numPixels;
+        }
+
+        uint16_t getNumFrames() const {
+            return _numFrames;
+        }
+
+        // index of the next frame
+        uint16_t getFrame() const {
+            return _frame;
+        }
+
+        uint16_t getFrameDelay() const {
+            return _frameDelay;
+        }
+
+        // returns true if showSource() can be used
+        bool canSendDirect() const {
+            return _flags & RLE::kFlagNoDelta;
+        }
+
+        void rewind() {
+            _reader = RLE::FlashReader(_animation + RLE::kHeaderSize);
+            _frame = 0;
+        }
+
+        // decode the next frame into pixels. only changed pixels are written
+        // returns the number of pixels that have been changed
+        uint16_t decodeFrame(_PixelType *pixels, uint16_t numPixels) {
+            uint16_t pos = 0;
+            uint16_t changed = 0;
+            for(;;) {
+                uint8_t command = _reader.read();
+                uint8_t type = command & RLE::kTypeMask;
+                if (type == RLE::kControl) {
+                    break;
+                }
+                uint8_t count = (command & RLE::kCountMask) + 1;
+                switch(type) {
+                    case RLE::kSkip:
+                        pos += count;
+                        break;
+                    case RLE::kRun: {
+                            auto color = _reader.readColor<_PixelType>();
+                            if (pos < numPixels) {
+                                uint16_t num = std::min<uint16_t>(count, numPixels - pos);
+                                fillPixels(pixels + pos, num, color);
+                                changed += num;
+                            }
+                            pos += count;
+                        }
+                        break;
+                    default:
+                        for(; count; count--) {
+                            auto color = _reader.readColor<_PixelType>();
+                            if (pos < numPixels) {
+                                pixels[pos] = color;
+                                changed++;
+                            }
+                            pos++;
+                        }
+                        break;
+                }
+            }
+            _nextFrame();
+            return changed;
+        }
+
+        template<typename _Ta>
+        uint16_t decodeFrame(_Ta &data) {
+            auto changed = decodeFrame(data.data(), data.size());
+            if (changed) {
+                markDirtyRange(data, 0, data.size());
+            }
+            return changed;
+        }
+
+        // skip the next frame without decoding
+        void skipFrame() {
+            for(;;) {
+                uint8_t command = _reader.read();
+                uint8_t type = command & RLE::kTypeMask;
+                if (type == RLE::kControl) {
+                    break;
+                }
+                uint8_t count = (command & RLE::kCountMask) + 1;
+                uint16_t numBytes = (type == RLE::kRun) ? 3 : (type == RLE::kLiteral) ? count * 3 : 0;
+                while (numBytes--) {
+                    _reader.read();
+                }
+            }
+            _nextFrame();
+        }
+
+        // source to send the next frame without pixel buffer. brightness is 0-256
+        // call skipFrame() after the frame has been sent
+        //
+        // flash cache misses during the output can exceed the time between 2 bits and abort the frame
+        // if NEOPIXEL_ALLOW_INTERRUPTS is enabled
+        source_type getSource(uint16_t brightness) const {
+            return source_type(_reader, _numPixels, brightness);
+        }
+
+    private:
+        void _nextFrame() {
+            if (++_frame >= _numFrames) {
+                rewind();
+            }
+        }
+
+    private:
+        const uint8_t *_animation;
+        uint16_t _numPixels;
+        uint16_t _numFrames;
+        uint16_t _frameDelay;
+        uint16_t _flags;
+        RLE::FlashReader _reader;
+        uint16_t _frame;
+    };
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
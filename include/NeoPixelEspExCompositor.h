@@ -0,0 +1,301 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+// max. number of layers per Compositor
+#ifndef NEOPIXEL_MAX_LAYERS
+#   define NEOPIXEL_MAX_LAYERS 4
+#endif
+
+namespace NeoPixelEx {
+
+    enum class BlendMode : uint8_t {
+        NORMAL,
+        ADD,
+        MULTIPLY,
+        MAX,
+    };
+
+    // combine a and b with mode, scale is the opacity 0-256
+    // the result is the same as compositePixels()
+    __attribute__((always_inline)) inline uint8_t compositeByte(uint8_t a, uint8_t b, BlendMode mode, uint16_t scale)
+    {
+        switch(mode) {
+            case BlendMode::ADD:
+                return std::min(255, a + ((b * scale) >> 8));
+            case BlendMode::MULTIPLY:
+                return a - (((a - ((a * (b + 1)) >> 8)) * scale) >> 8);
+            case BlendMode::MAX:
+                return (b > a) ? a + (((b - a) * scale) >> 8) : a;
+            default:
+                break;
+        }
+        return (a * (256 - scale) + b * scale) >> 8;
+    }
+
+    // combine numPixels of src with pixels, opacity 0-255
+    template<typename _PixelType>
+    inline void compositePixels(_PixelType *pixels, const _PixelType *src, size_t numPixels, BlendMode mode, uint8_t opacity)
+    {
+        uint16_t scale = blendAmount(opacity);
+        auto dst = reinterpret_cast<uint8_t *>(pixels);
+        auto srcBytes = reinterpret_cast<const uint8_t *>(src);
+        auto numBytes = numPixels * sizeof(_PixelType);
+        switch(mode) {
+            case BlendMode::NORMAL:
+                if (scale == 256) {
+                    std::copy_n(src, numPixels, pixels);
+                }
+                else {
+                    blendPixels(pixels, pixels, src, numPixels, opacity);
+                }
+                break;
+            case BlendMode::ADD:
+                if (scale == 256) {
+                    addSaturatePixels(pixels, src, numPixels);
+                }
+                else {
+                    transformBytes(dst, srcBytes, numBytes, [scale](uint32_t a, uint32_t b) {
+                        return SWAR::addSaturate(a, SWAR::scale(b, scale));
+                    });
+                }
+                break;
+            case BlendMode::MAX:
+                // a + max(b - a, 0) cannot carry into the next byte
+                transformBytes(dst, srcBytes, numBytes, [scale](uint32_t a, uint32_t b) {
+                    return a + SWAR::scale(SWAR::subSaturate(b, a), scale);
+                });
+                break;
+            default:
+                // the product of 2 bytes does not fit into a byte lane
+                for(auto end = dst + numBytes; dst < end; dst++) {
+                    *dst = compositeByte(*dst, *srcBytes++, mode, scale);
+                }
+                break;
+        }
+    }
+
+    template<typename _Compositor>
+    class CompositorSource;
+
+    // combines up to NEOPIXEL_MAX_LAYERS layers
+    //
+    // each layer covers a range of pixels starting at offset, pixels outside the range are transparent
+    // and do not cost any time. layers can be PixelData, DataWrapper or any type derived from SourceDataType
+    // that provides get(index), like GeneratorPixelData and IndexedPixelData
+    //
+    // the result is either stored in a pixel buffer with compose() or created while sending by using the
+    // compositor as data type of a Strip. the time between 2 bytes is limited and only a few layers can be
+    // combined while sending, depending on the CPU frequency
+    template<uint16_t _NumPixels, typename _PixelType = GRB>
+    class Compositor : public SourceDataType
+    {
+    public:
+        using pixel_type = _PixelType;
+        using source_type = CompositorSource<Compositor>;
+        using getter_type = pixel_type (*)(void *object, uint16_t index);
+
+        static constexpr uint16_t kNumPixels = _NumPixels;
+
+        struct Layer {
+            const pixel_type *pixels;
+            void *object;
+            getter_type get;
+            uint16_t offset;
+            uint16_t numPixels;
+            BlendMode mode;
+            uint8_t opacity;
+            bool enabled;
+
+            __attribute__((always_inline)) inline pixel_type getPixel(uint16_t index) const {
+                return pixels ? pixels[index] : get(object, index);
+            }
+        };
+
+    public:
+        Compositor() : _numLayers(0) {}
+
+        static constexpr uint16_t size() {
+            return kNumPixels;
+        }
+
+        static constexpr uint16_t getNumPixels() {
+            return kNumPixels;
+        }
+
+        // add layer and return its index or -1
+        // data must provide numPixels pixels starting at index 0, which are displayed starting at offset
+        template<typename _Ta>
+        int8_t add(_Ta &data, BlendMode mode = BlendMode::NORMAL, uint8_t opacity = 255, uint16_t offset = 0, uint16_t numPixels = _Ta::size()) {
+            if (_numLayers >= NEOPIXEL_MAX_LAYERS) {
+                return -1;
+            }
+            auto &layer = _layers[_numLayers];
+            _setData(layer, data, std::is_base_of<SourceDataType, _Ta>());
+            layer.offset = offset;
+            layer.numPixels = numPixels;
+            layer.mode = mode;
+            layer.opacity = opacity;
+            layer.enabled = true;
+            return _numLayers++;
+        }
+
+        void clear() {
+            _numLayers = 0;
+        }
+
+        Layer &layer(uint8_t index) {
+            return _layers[index];
+        }
+
+        const Layer &layer(uint8_t index) const {
+            return _layers[index];
+        }
+
+        uint8_t getNumLayers() const {
+            return _numLayers;
+        }
+
+        // color of all pixels that are not covered by any layer
+        void fill(const pixel_type &color) {
+            _background = color;
+        }
+
+        const pixel_type &getBackground() const {
+            return _background;
+        }
+
+        // store the result in pixels, which must provide kNumPixels
+        void compose(pixel_type *pixels) const {
+            fillPixels(pixels, kNumPixels, _background);
+            for(uint8_t i = 0; i < _numLayers; i++) {
+                auto &layer = _layers[i];
+                if (!layer.enabled || layer.opacity == 0 || layer.offset >= kNumPixels) {
+                    continue;
+                }
+                uint16_t numPixels = std::min<uint16_t>(layer.numPixels, kNumPixels - layer.offset);
+                auto dst = pixels + layer.offset;
+                if (layer.pixels) {
+                    compositePixels(dst, layer.pixels, numPixels, layer.mode, layer.opacity);
+                }
+                else {
+                    // the pixels of generators are created in small chunks to use the same kernels
+                    static constexpr uint8_t kChunkSize = 16;
+                    pixel_type chunk[kChunkSize];
+                    for(uint16_t index = 0; index < numPixels; index += kChunkSize) {
+                        uint8_t count = std::min<uint16_t>(kChunkSize, numPixels - index);
+                        for(uint8_t j = 0; j < count; j++) {
+                            chunk[j] = layer.get(layer.object, index + j);
+                        }
+                        compositePixels(dst + index, chunk, count, layer.mode, layer.opacity);
+                    }
+                }
+            }
+        }
+
+        template<typename _Ta>
+        void compose(_Ta &data) {
+            markDirtyRange(data, 0, kNumPixels);
+            compose(data.data());
+        }
+
+        // combine a single pixel
+        pixel_type get(uint16_t index) const {
+            auto color = _background;
+            auto dst = reinterpret_cast<uint8_t *>(&color);
+            for(uint8_t i = 0; i < _numLayers; i++) {
+                auto &layer = _layers[i];
+                uint16_t layerIndex = index - layer.offset;
+                if (!layer.enabled || layerIndex >= layer.numPixels) {
+                    continue;
+                }
+                auto src = layer.getPixel(layerIndex);
+                auto srcBytes = reinterpret_cast<const uint8_t *>(&src);
+                uint16_t scale = blendAmount(layer.opacity);
+                for(uint8_t j = 0; j < sizeof(pixel_type); j++) {
+                    dst[j] = compositeByte(dst[j], srcBytes[j], layer.mode, scale);
+                }
+            }
+            return color;
+        }
+
+        source_type getSource(uint16_t brightness) const {
+            return source_type(*this, kNumPixels, brightness);
+        }
+
+    private:
+        template<typename _Ta>
+        void _setData(Layer &layer, _Ta &data, std::false_type) {
+            layer.pixels = data.data();
+            layer.object = nullptr;
+            layer.get = nullptr;
+        }
+
+        template<typename _Ta>
+        void _setData(Layer &layer, _Ta &data, std::true_type) {
+            layer.pixels = nullptr;
+            layer.object = &data;
+            layer.get = [](void *object, uint16_t index) -> pixel_type {
+                return reinterpret_cast<_Ta *>(object)->get(index);
+            };
+        }
+
+    private:
+        Layer _layers[NEOPIXEL_MAX_LAYERS];
+        uint8_t _numLayers;
+        pixel_type _background;
+    };
+
+    // combines the layers while sending, one pixel at a time
+    template<typename _Compositor>
+    class CompositorSource {
+    public:
+        using pixel_type = typename _Compositor::pixel_type;
+
+        CompositorSource(const _Compositor &compositor, uint16_t numPixels, uint16_t brightness) :
+            _compositor(compositor),
+            _numBytes(numPixels * sizeof(pixel_type)),
+            _index(0),
+            _byte(0),
+            _brightness(brightness)
+        {
+        }
+
+        __attribute__((always_inline)) inline bool available() const {
+            return _numBytes != 0;
+        }
+
+        __attribute__((always_inline)) inline uint8_t load() {
+            if (_byte == 0) {
+                _color = _compositor.get(_index++);
+            }
+            uint8_t value = _order.get(reinterpret_cast<const uint8_t *>(&_color) + _byte);
+            _order.next();
+            _byte = (_byte == sizeof(pixel_type) - 1) ? 0 : _byte + 1;
+            _numBytes--;
+            return (value * _brightness) >> 8;
+        }
+
+    private:
+        const _Compositor &_compositor;
+        uint16_t _numBytes;
+        uint16_t _index;
+        uint8_t _byte;
+        uint16_t _brightness;
+        pixel_type _color;
+        PixelOrder<pixel_type> _order;
+    };
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
@@ -0,0 +1,348 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+// max. number of effects per EffectEngine
+#ifndef NEOPIXEL_MAX_EFFECTS
+#   define NEOPIXEL_MAX_EFFECTS 4
+#endif
+
+namespace NeoPixelEx {
+
+    // the time of all effects is 16.16 fixed point in seconds and wraps around after ~18 hours
+    // effects should calculate their output from the time only to be independent of the frame rate
+    using effect_time_t = uint32_t;
+
+    static constexpr effect_time_t kEffectTimeSecond = 0x10000;
+
+    // 16.16 fixed point time for an interval in microseconds
+    inline effect_time_t microsToEffectTime(uint64_t micros) {
+        // 2^32 * 65536 / 1000000
+        return (micros * 281474977ULL) >> 32;
+    }
+
+    #if NEOPIXEL_HAVE_STATS
+
+        class RenderStats {
+        public:
+            RenderStats() : _renders(0), _skipped(0), _totalMicros(0), _maxMicros(0) {}
+
+            void clear() {
+                *this = RenderStats();
+            }
+
+            // number of frames that changed the output
+            uint32_t getRenders() const {
+                return _renders;
+            }
+
+            // number of frames without changes
+            uint32_t getSkipped() const {
+                return _skipped;
+            }
+
+            // average time per call in microseconds, including skipped frames
+            uint32_t getAvgMicros() const {
+                auto count = _renders + _skipped;
+                return count ? _totalMicros / count : 0;
+            }
+
+            uint32_t getMaxMicros() const {
+                return _maxMicros;
+            }
+
+            void add(bool changed, uint32_t micros) {
+                if (changed) {
+                    _renders++;
+                }
+                else {
+                    _skipped++;
+                }
+                _totalMicros += micros;
+                _maxMicros = std::max(_maxMicros, micros);
+            }
+
+        private:
+            uint32_t _renders;
+            uint32_t _skipped;
+            uint32_t _totalMicros;
+            uint32_t _maxMicros;
+        };
+
+    #endif
+
+    // base class for effects
+    // the pixel buffer passed to render() contains the output of the previous call, unless isInvalid() returns true
+    template<typename _PixelType>
+    class Effect {
+    public:
+        using pixel_type = _PixelType;
+
+    public:
+        Effect() : _invalid(true) {}
+        virtual ~Effect() {}
+
+        // returns false if the output did not change
+        virtual bool render(pixel_type *pixels, uint16_t numPixels, effect_time_t time) = 0;
+
+        // render all pixels with the next call, for example after changing parameters
+        void invalidate() {
+            _invalid = true;
+        }
+
+        bool isInvalid() const {
+            return _invalid;
+        }
+
+        bool update(pixel_type *pixels, uint16_t numPixels, effect_time_t time) {
+            #if NEOPIXEL_HAVE_STATS
+                uint32_t start = micros();
+            #endif
+            bool changed = render(pixels, numPixels, time) || _invalid;
+            _invalid = false;
+            #if NEOPIXEL_HAVE_STATS
+                _stats.add(changed, micros() - start);
+            #endif
+            return changed;
+        }
+
+        #if NEOPIXEL_HAVE_STATS
+            RenderStats &getStats() {
+                return _stats;
+            }
+        #endif
+
+    private:
+        bool _invalid;
+        #if NEOPIXEL_HAVE_STATS
+            RenderStats _stats;
+        #endif
+    };
+
+    // renders the effects of a strip and displays the frame if any effect changed its output
+    template<typename _Strip>
+    class EffectEngine {
+    public:
+        using strip_type = _Strip;
+        using pixel_type = typename _Strip::pixel_type;
+        using effect_type = Effect<pixel_type>;
+
+        static_assert(!std::is_base_of<SourceDataType, typename _Strip::data_type>::value, "strip requires a pixel buffer");
+
+    public:
+        EffectEngine(strip_type &strip) :
+            _strip(strip),
+            _numEffects(0),
+            _brightness(255),
+            _lastMicros(micros()),
+            _micros(0),
+            _time(0)
+        {
+        }
+
+        // add effect for numPixels starting at offset
+        bool add(effect_type &effect, uint16_t offset = 0, uint16_t numPixels = _Strip::size()) {
+            if (_numEffects >= NEOPIXEL_MAX_EFFECTS || offset >= _Strip::size() || numPixels == 0) {
+                return false;
+            }
+            effect.invalidate();
+            _effects[_numEffects++] = { &effect, offset, std::min<uint16_t>(numPixels, _Strip::size() - offset) };
+            return true;
+        }
+
+        void remove(effect_type &effect) {
+            auto end = std::remove_if(_effects, _effects + _numEffects, [&effect](const Item &item) {
+                return item.effect == &effect;
+            });
+            _numEffects = end - _effects;
+        }
+
+        void clear() {
+            _numEffects = 0;
+        }
+
+        void setBrightness(uint8_t brightness) {
+            if (brightness != _brightness) {
+                _brightness = brightness;
+                invalidate();
+            }
+        }
+
+        uint8_t getBrightness() const {
+            return _brightness;
+        }
+
+        void invalidate() {
+            for(uint8_t i = 0; i < _numEffects; i++) {
+                _effects[i].effect->invalidate();
+            }
+        }
+
+        // restart all effects at time 0
+        void resetTime() {
+            _micros = 0;
+            _time = 0;
+            _lastMicros = micros();
+            invalidate();
+        }
+
+        effect_time_t getTime() const {
+            return _time;
+        }
+
+        // call from loop(), the frames are limited by the min. display period of the chipset
+        // returns true if a new frame was displayed
+        bool loop() {
+            if (!_strip.canShow()) {
+                return false;
+            }
+            uint32_t now = micros();
+            _micros += now - _lastMicros;
+            _lastMicros = now;
+            _time = microsToEffectTime(_micros);
+
+            bool changed = false;
+            auto pixels = _strip.data().data();
+            for(uint8_t i = 0; i < _numEffects; i++) {
+                auto &item = _effects[i];
+                if (item.effect->update(pixels + item.offset, item.numPixels, _time)) {
+                    markDirtyRange(_strip.data(), item.offset, item.numPixels);
+                    changed = true;
+                }
+            }
+            if (changed) {
+                _strip.show(_brightness);
+            }
+            return changed;
+        }
+
+    private:
+        struct Item {
+            effect_type *effect;
+            uint16_t offset;
+            uint16_t numPixels;
+        };
+
+        strip_type &_strip;
+        Item _effects[NEOPIXEL_MAX_EFFECTS];
+        uint8_t _numEffects;
+        uint8_t _brightness;
+        uint32_t _lastMicros;
+        uint64_t _micros;
+        effect_time_t _time;
+    };
+
+    // rainbow moving at hueSpeed hue steps per second
+    template<typename _PixelType>
+    class RainbowEffect : public Effect<_PixelType> {
+    public:
+        using Effect<_PixelType>::isInvalid;
+        using Effect<_PixelType>::invalidate;
+
+        RainbowEffect(uint16_t hueSpeed = 64, uint8_t deltaHue = 4, uint8_t sat = 255, uint8_t val = 255) :
+            _hueSpeed(hueSpeed),
+            _deltaHue(deltaHue),
+            _sat(sat),
+            _val(val),
+            _hue(0)
+        {
+        }
+
+        void setHueSpeed(uint16_t hueSpeed) {
+            _hueSpeed = hueSpeed;
+        }
+
+        void setDeltaHue(uint8_t deltaHue) {
+            _deltaHue = deltaHue;
+            invalidate();
+        }
+
+        void setSaturation(uint8_t sat) {
+            _sat = sat;
+            invalidate();
+        }
+
+        void setValue(uint8_t val) {
+            _val = val;
+            invalidate();
+        }
+
+        virtual bool render(_PixelType *pixels, uint16_t numPixels, effect_time_t time) override {
+            uint8_t hue = (time * _hueSpeed) >> 16;
+            if (hue == _hue && !isInvalid()) {
+                return false;
+            }
+            _hue = hue;
+            rainbowPixels(pixels, numPixels, HSV(hue, _sat, _val), _deltaHue);
+            return true;
+        }
+
+    private:
+        uint16_t _hueSpeed;
+        uint8_t _deltaHue;
+        uint8_t _sat;
+        uint8_t _val;
+        uint8_t _hue;
+    };
+
+    // single pixel moving at speed pixels per second. only the previous and the current pixel are written
+    template<typename _PixelType>
+    class ChaseEffect : public Effect<_PixelType> {
+    public:
+        using Effect<_PixelType>::isInvalid;
+        using Effect<_PixelType>::invalidate;
+
+        ChaseEffect(const _PixelType &color, const _PixelType &background = _PixelType(), uint16_t speed = 30) :
+            _color(color),
+            _background(background),
+            _speed(speed),
+            _pos(0)
+        {
+        }
+
+        void setColor(const _PixelType &color, const _PixelType &background = _PixelType()) {
+            _color = color;
+            _background = background;
+            invalidate();
+        }
+
+        void setSpeed(uint16_t speed) {
+            _speed = speed;
+        }
+
+        virtual bool render(_PixelType *pixels, uint16_t numPixels, effect_time_t time) override {
+            uint16_t pos = ((static_cast<uint64_t>(time) * _speed) >> 16) % numPixels;
+            if (isInvalid()) {
+                fillPixels(pixels, numPixels, _background);
+            }
+            else if (pos == _pos) {
+                return false;
+            }
+            else {
+                pixels[_pos] = _background;
+            }
+            pixels[pos] = _color;
+            _pos = pos;
+            return true;
+        }
+
+    private:
+        _PixelType _color;
+        _PixelType _background;
+        uint16_t _speed;
+        uint16_t _pos;
+    };
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
@@ -0,0 +1,252 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#if ESP8266
+#   include <i2s_reg.h>
+#endif
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+namespace NeoPixelEx {
+
+    // I2S output for ESP8266
+    //
+    // each bit is encoded as 4 I2S bits, 0 = 1000 and 1 = 1110. the high time is 1/4 or 3/4 of the period of the
+    // chipset, 312/937ns for 800kHz. the timings T0H and T1H of the chipset are not used
+    //
+    // the data is sent by DMA and cannot be interrupted. show() encodes the frame into the second buffer while the
+    // previous frame is still being sent and returns after starting the transfer. the I2S data output is GPIO3 (RX)
+    namespace I2S {
+
+        static constexpr uint8_t kBitsPerBit = 4;
+        // max. size of a DMA descriptor is 4095 byte, multiple of 4
+        static constexpr uint16_t kMaxDescriptorSize = 4092;
+        // I2S base clock
+        static constexpr uint32_t kBaseClock = 160000000UL;
+
+        // 4 bits of data encoded as 16 I2S bits, MSB first
+        constexpr uint16_t encodeNibble(uint8_t nibble) {
+            return ((nibble & 8) ? 0xe000 : 0x8000) | ((nibble & 4) ? 0x0e00 : 0x0800) | ((nibble & 2) ? 0x00e0 : 0x0080) | ((nibble & 1) ? 0x000e : 0x0008);
+        }
+
+        struct NibbleTable {
+            uint16_t value[16];
+
+            constexpr NibbleTable() : value{} {
+                for(uint8_t i = 0; i < 16; i++) {
+                    value[i] = encodeNibble(i);
+                }
+            }
+        };
+
+        static constexpr NibbleTable kNibbleTable = NibbleTable();
+
+        // the I2S unit sends 32 bit words MSB first. in little endian memory, the second 16 bit word is the upper half
+        // and sent first. each byte is stored as 2 words, low nibble first. returns the end of the encoded data
+        template<typename _Source>
+        inline uint16_t *encode(uint16_t *dst, _Source &source) {
+            while (source.available()) {
+                uint8_t value = source.load();
+                *dst++ = kNibbleTable.value[value & 0x0f];
+                *dst++ = kNibbleTable.value[value >> 4];
+            }
+            return dst;
+        }
+
+        // divider of the base clock for 4 I2S bits per period, split into bck_div and clkm_div (2-63 each)
+        template<typename _Chipset>
+        struct ClockDivider {
+            static constexpr uint32_t kDivider = (kBaseClock / 1000000UL * _Chipset::kNanosPeriod / kBitsPerBit + 500) / 1000;
+
+            static constexpr uint8_t findBckDiv(uint8_t bckDiv = 2) {
+                return (bckDiv >= 63 || (kDivider % bckDiv == 0 && kDivider / bckDiv <= 63)) ? bckDiv : findBckDiv(bckDiv + 1);
+            }
+
+            static constexpr uint8_t kBckDiv = findBckDiv();
+            static constexpr uint8_t kClkmDiv = kDivider / kBckDiv;
+
+            static_assert(kClkmDiv >= 2 && kClkmDiv <= 63, "period of the chipset cannot be used with I2S");
+        };
+
+        // SLC DMA descriptor
+        struct SlcDescriptor {
+            uint32_t blocksize: 12;
+            uint32_t datalen: 12;
+            uint32_t unused: 5;
+            uint32_t sub_sof: 1;
+            uint32_t eof: 1;
+            uint32_t owner: 1;
+            const void *buffer;
+            SlcDescriptor *next;
+        };
+
+    }
+
+    #if ESP8266
+
+        // output backend, see DefaultOutput
+        template<uint16_t _NumBytes, typename _Chipset>
+        class I2SDma {
+        public:
+            using chipset_type = _Chipset;
+            using clock_type = I2S::ClockDivider<_Chipset>;
+
+            static constexpr uint16_t kNumWords = _NumBytes * 2;
+            static constexpr uint32_t kBufferSize = kNumWords * sizeof(uint16_t);
+            static constexpr uint8_t kNumDescriptors = (kBufferSize + I2S::kMaxDescriptorSize - 1) / I2S::kMaxDescriptorSize;
+            // zeros sent after each frame, rounded up to 32 bit words
+            static constexpr uint16_t kResetSize = ((_Chipset::kResetDelay * 1000UL * I2S::kBitsPerBit / _Chipset::kNanosPeriod + 7) / 8 + 3) & ~3;
+            // time to send a frame including the reset in microseconds
+            static constexpr uint32_t kFrameTime = (_NumBytes * 8UL * _Chipset::kNanosPeriod) / 1000UL + _Chipset::kResetDelay;
+
+            static constexpr bool kBrightness = false;
+
+            static constexpr bool isValidPin(uint8_t pin) {
+                return pin == 3;
+            }
+
+        public:
+            I2SDma() : _next(0), _busy(false) {}
+
+            void begin() {
+                _setupDescriptors();
+
+                pinMode(3, FUNCTION_1);
+                I2S_CLK_ENABLE();
+                I2SIC = 0x3f;
+                I2SIE = 0;
+
+                // reset I2S and enable DMA
+                I2SC &= ~I2SRST;
+                I2SC |= I2SRST;
+                I2SC &= ~I2SRST;
+                I2SFC &= ~(I2SDE | (I2STXFMM << I2STXFM) | (I2SRXFMM << I2SRXFM));
+                I2SFC |= I2SDE;
+                I2SCC &= ~((I2STXCMM << I2STXCM) | (I2SRXCMM << I2SRXCM));
+                I2SC &= ~(I2STSM | I2SRSM | (I2SBMM << I2SBM) | (I2SBDM << I2SBD) | (I2SCDM << I2SCD));
+                I2SC |= I2SRF | I2SMR | I2SRSM | I2SRMS | ((clock_type::kBckDiv & I2SBDM) << I2SBD) | ((clock_type::kClkmDiv & I2SCDM) << I2SCD);
+
+                // reset SLC and link the DMA to I2S
+                SLCC0 |= SLCRXLR | SLCTXLR;
+                SLCC0 &= ~(SLCRXLR | SLCTXLR);
+                SLCIC = 0xffffffff;
+                SLCC0 &= ~(SLCMM << SLCM);
+                SLCC0 |= (1 << SLCM);
+                SLCRXDC |= SLCBINR | SLCBTNR;
+                SLCRXDC &= ~(SLCBRXFE | SLCBRXEM | SLCBRXFM);
+                SLCIE = 0;
+                // the TX link is not used but requires a valid descriptor
+                SLCTXL &= ~(SLCTXLAM << SLCTXLA);
+                SLCTXL |= (reinterpret_cast<uintptr_t>(&_idle) & SLCTXLAM) << SLCTXLA;
+
+                // send zeros until the first frame
+                _dmaStart(&_idle);
+                I2SC |= I2STXS;
+                _busy = false;
+            }
+
+            void end() {
+                wait();
+                SLCRXL |= SLCRXLE;
+                I2SC &= ~I2STXS;
+                pinMode(3, INPUT);
+            }
+
+            // encode the next frame while the previous frame is sent, then start the transfer
+            template<typename _Source>
+            bool show(_Source &source, Context &context) {
+                auto buffer = _buffers[_next];
+                auto end = I2S::encode(buffer, source);
+                std::fill(end, buffer + kNumWords, 0);
+
+                wait();
+                _dmaStart(_descriptors[_next]);
+                _next ^= 1;
+
+                #if NEOPIXEL_HAVE_STATS
+                    context.getStats().increment(true);
+                #endif
+                // the frame is still being sent for kFrameTime microseconds
+                context.setLastDisplayTime(micros());
+                return true;
+            }
+
+            // returns true until the last frame including the reset has been sent
+            bool isBusy() const {
+                return _busy && !(SLCIR & SLCIRXEOF);
+            }
+
+            void wait() {
+                uint32_t start = micros();
+                while (isBusy() && micros() - start < kFrameTime * 2 + 1000) {
+                }
+                _busy = false;
+            }
+
+        private:
+            void _setupDescriptors() {
+                for(uint8_t i = 0; i < 2; i++) {
+                    auto ptr = reinterpret_cast<const uint8_t *>(_buffers[i]);
+                    uint32_t remaining = kBufferSize;
+                    for(uint8_t j = 0; j < kNumDescriptors; j++) {
+                        uint16_t size = std::min<uint32_t>(remaining, I2S::kMaxDescriptorSize);
+                        _setDescriptor(_descriptors[i][j], ptr, size, false, (j == kNumDescriptors - 1) ? &_reset : &_descriptors[i][j + 1]);
+                        ptr += size;
+                        remaining -= size;
+                    }
+                }
+                // the end of frame flag is set after the reset has been sent. the idle descriptor keeps the output low
+                _setDescriptor(_reset, _zeros, sizeof(_zeros), true, &_idle);
+                _setDescriptor(_idle, _zeros, sizeof(_zeros), false, &_idle);
+            }
+
+            static void _setDescriptor(I2S::SlcDescriptor &desc, const void *buffer, uint16_t size, bool eof, I2S::SlcDescriptor *next) {
+                desc.owner = 1;
+                desc.eof = eof;
+                desc.sub_sof = 0;
+                desc.unused = 0;
+                desc.datalen = size;
+                desc.blocksize = size;
+                desc.buffer = buffer;
+                desc.next = next;
+            }
+
+            void _dmaStart(I2S::SlcDescriptor *desc) {
+                SLCRXL |= SLCRXLE;
+                SLCIC = 0xffffffff;
+                SLCRXL &= ~(SLCRXLAM << SLCRXLA);
+                SLCRXL |= (reinterpret_cast<uintptr_t>(desc) & SLCRXLAM) << SLCRXLA;
+                SLCRXL |= SLCRXLS;
+                _busy = true;
+            }
+
+        private:
+            alignas(4) uint16_t _buffers[2][kNumWords];
+            alignas(4) uint8_t _zeros[kResetSize] = {};
+            I2S::SlcDescriptor _descriptors[2][kNumDescriptors];
+            I2S::SlcDescriptor _reset;
+            I2S::SlcDescriptor _idle;
+            uint8_t _next;
+            volatile bool _busy;
+        };
+
+        // Strip<3, 300, GRB, TimingsWS2812, PixelData<300, GRB>, I2SDmaOutput>
+        struct I2SDmaOutput {
+            template<uint16_t _NumBytes, typename _Chipset>
+            using type = I2SDma<_NumBytes, _Chipset>;
+        };
+
+    #endif
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
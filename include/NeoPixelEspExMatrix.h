@@ -0,0 +1,262 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+namespace NeoPixelEx {
+
+    // layouts return the index of the LED that is wired at x, y
+    //
+    // static constexpr uint16_t index(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
+
+    // all rows start on the left
+    struct RowMajorLayout {
+        static constexpr uint16_t index(uint16_t x, uint16_t y, uint16_t width, uint16_t) {
+            return y * width + x;
+        }
+    };
+
+    // odd rows start on the right
+    struct SerpentineLayout {
+        static constexpr uint16_t index(uint16_t x, uint16_t y, uint16_t width, uint16_t) {
+            return y * width + ((y & 1) ? width - 1 - x : x);
+        }
+    };
+
+    // all columns start at the top
+    struct ColumnMajorLayout {
+        static constexpr uint16_t index(uint16_t x, uint16_t y, uint16_t, uint16_t height) {
+            return x * height + y;
+        }
+    };
+
+    // odd columns start at the bottom
+    struct ColumnSerpentineLayout {
+        static constexpr uint16_t index(uint16_t x, uint16_t y, uint16_t, uint16_t height) {
+            return x * height + ((x & 1) ? height - 1 - y : y);
+        }
+    };
+
+    // panels of _TileWidth x _TileHeight pixels using _TileLayout. the panels are connected in the order of _PanelLayout
+    // the size of the matrix must be a multiple of the panel size
+    template<uint16_t _TileWidth, uint16_t _TileHeight, typename _TileLayout = SerpentineLayout, typename _PanelLayout = RowMajorLayout>
+    struct TiledLayout {
+        static constexpr uint16_t index(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+            return _PanelLayout::index(x / _TileWidth, y / _TileHeight, width / _TileWidth, height / _TileHeight) * (_TileWidth * _TileHeight) +
+                _TileLayout::index(x % _TileWidth, y % _TileHeight, _TileWidth, _TileHeight);
+        }
+    };
+
+    // maps the LED index to the pixel index in raster order, created at compile time
+    template<uint16_t _Width, uint16_t _Height, typename _Layout>
+    struct MatrixIndexMap {
+        uint16_t index[_Width * _Height];
+
+        constexpr MatrixIndexMap() : index{} {
+            for(uint16_t y = 0; y < _Height; y++) {
+                for(uint16_t x = 0; x < _Width; x++) {
+                    index[_Layout::index(x, y, _Width, _Height)] = y * _Width + x;
+                }
+            }
+        }
+
+        // returns true if each pixel is mapped to a different LED
+        constexpr bool isValid() const {
+            bool used[_Width * _Height] = {};
+            for(uint16_t i = 0; i < _Width * _Height; i++) {
+                if (used[index[i]]) {
+                    return false;
+                }
+                used[index[i]] = true;
+            }
+            return true;
+        }
+    };
+
+    // reads the pixels in the order of the LEDs
+    template<typename _Matrix>
+    class MatrixSource {
+    public:
+        using pixel_type = typename _Matrix::pixel_type;
+
+        MatrixSource(const pixel_type *pixels, uint16_t brightness) :
+            _pixels(pixels),
+            _index(_Matrix::kIndexMap.index),
+            _numBytes(_Matrix::kNumPixels * sizeof(pixel_type)),
+            _byte(0),
+            _brightness(brightness)
+        {
+        }
+
+        __attribute__((always_inline)) inline bool available() const {
+            return _numBytes != 0;
+        }
+
+        __attribute__((always_inline)) inline uint8_t load() {
+            if (_byte == 0) {
+                _pixel = reinterpret_cast<const uint8_t *>(&_pixels[pgm_read_word(_index++)]);
+            }
+            uint8_t value = _order.get(_pixel + _byte);
+            _order.next();
+            _byte = (_byte == sizeof(pixel_type) - 1) ? 0 : _byte + 1;
+            _numBytes--;
+            return (value * _brightness) >> 8;
+        }
+
+    private:
+        const pixel_type *_pixels;
+        const uint16_t *_index;
+        const uint8_t *_pixel;
+        uint16_t _numBytes;
+        uint8_t _byte;
+        uint16_t _brightness;
+        PixelOrder<pixel_type> _order;
+    };
+
+    // pixels stored in raster order, row by row starting at the top left
+    // the wiring of the LEDs is applied while sending with a single index lookup per pixel. the index map is stored in PROGMEM
+    template<uint16_t _Width, uint16_t _Height, typename _Layout = SerpentineLayout, typename _PixelType = GRB>
+    class Matrix : public SourceDataType, public PixelKernels<Matrix<_Width, _Height, _Layout, _PixelType>, _PixelType>
+    {
+    public:
+        using pixel_type = _PixelType;
+        using layout_type = _Layout;
+        using source_type = MatrixSource<Matrix>;
+        using index_map_type = MatrixIndexMap<_Width, _Height, _Layout>;
+        using data_type = std::array<pixel_type, _Width * _Height>;
+
+        static constexpr uint16_t kWidth = _Width;
+        static constexpr uint16_t kHeight = _Height;
+        static constexpr uint16_t kNumPixels = _Width * _Height;
+
+        static constexpr index_map_type kIndexMap PROGMEM = index_map_type();
+
+        static_assert(kIndexMap.isValid(), "the layout does not map each pixel to a different LED");
+
+    public:
+        Matrix() : _data{} {}
+
+        static constexpr uint16_t size() {
+            return kNumPixels;
+        }
+
+        static constexpr uint16_t getNumPixels() {
+            return kNumPixels;
+        }
+
+        static constexpr uint16_t width() {
+            return kWidth;
+        }
+
+        static constexpr uint16_t height() {
+            return kHeight;
+        }
+
+        // index of x, y in the pixel data
+        static constexpr uint16_t XY(uint16_t x, uint16_t y) {
+            return y * kWidth + x;
+        }
+
+        // index of the LED at x, y
+        static constexpr uint16_t ledIndex(uint16_t x, uint16_t y) {
+            return _Layout::index(x, y, kWidth, kHeight);
+        }
+
+        pixel_type *data() {
+            return _data.data();
+        }
+
+        const pixel_type *data() const {
+            return _data.data();
+        }
+
+        pixel_type *begin() {
+            this->markDirty();
+            return data();
+        }
+
+        const pixel_type *begin() const {
+            return data();
+        }
+
+        pixel_type *end() {
+            this->markDirty();
+            return data() + kNumPixels;
+        }
+
+        const pixel_type *end() const {
+            return data() + kNumPixels;
+        }
+
+        // pointer to the first pixel of a row, which is marked as modified
+        pixel_type *row(uint16_t y) {
+            this->markDirty(y * kWidth, kWidth);
+            return data() + y * kWidth;
+        }
+
+        pixel_type &operator[](int index) {
+            this->markDirty(index);
+            return _data[index];
+        }
+
+        pixel_type operator[](int index) const {
+            return _data[index];
+        }
+
+        pixel_type &at(uint16_t x, uint16_t y) {
+            this->markDirty(XY(x, y));
+            return _data[XY(x, y)];
+        }
+
+        pixel_type at(uint16_t x, uint16_t y) const {
+            return _data[XY(x, y)];
+        }
+
+        void set(int index, pixel_type color) {
+            this->markDirty(index);
+            _data[index] = color;
+        }
+
+        void set(uint16_t x, uint16_t y, pixel_type color) {
+            this->markDirty(XY(x, y));
+            _data[XY(x, y)] = color;
+        }
+
+        pixel_type get(int index) const {
+            return _data[index];
+        }
+
+        pixel_type get(uint16_t x, uint16_t y) const {
+            return _data[XY(x, y)];
+        }
+
+        void fill(const pixel_type &color) {
+            this->markDirty();
+            fillPixels(data(), kNumPixels, color);
+        }
+
+        source_type getSource(uint16_t brightness) const {
+            return source_type(data(), brightness);
+        }
+
+    private:
+        alignas(4) data_type _data;
+    };
+
+#if __cplusplus < 201703L
+    template<uint16_t _Width, uint16_t _Height, typename _Layout, typename _PixelType>
+    constexpr MatrixIndexMap<_Width, _Height, _Layout> Matrix<_Width, _Height, _Layout, _PixelType>::kIndexMap;
+#endif
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
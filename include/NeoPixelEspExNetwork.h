@@ -0,0 +1,447 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+// max. number of strips a Network::Receiver can update
+#ifndef NEOPIXEL_NETWORK_MAX_OUTPUTS
+#   define NEOPIXEL_NETWORK_MAX_OUTPUTS 4
+#endif
+
+namespace NeoPixelEx {
+
+    // parser for DDP, E1.31 (sACN) and Art-Net packets
+    //
+    // the packets can be received with any UDP library and are passed to Receiver::process()
+    // E1.31 and Art-Net universes are mapped to a linear channel address
+    // (universe - firstUniverse) * channelsPerUniverse + channel, DDP uses the data offset
+    // the first universe is set per protocol, E1.31 starts at 1 and Art-Net at 0
+    namespace Network {
+
+        enum class Protocol : uint8_t {
+            NONE,
+            DDP,
+            E131,
+            ARTNET,
+        };
+
+        struct PacketInfo {
+            Protocol protocol;
+            // E1.31 or Art-Net universe
+            uint16_t universe;
+            // DDP data offset
+            uint32_t offset;
+            const uint8_t *data;
+            uint16_t length;
+            // DDP push flag, E1.31 and Art-Net sync packets
+            bool sync;
+        };
+
+        static constexpr uint16_t kDDPPort = 4048;
+        static constexpr uint16_t kE131Port = 5568;
+        static constexpr uint16_t kArtNetPort = 6454;
+
+        inline uint16_t readUint16BE(const uint8_t *ptr) {
+            return (ptr[0] << 8) | ptr[1];
+        }
+
+        inline uint32_t readUint32BE(const uint8_t *ptr) {
+            return (static_cast<uint32_t>(ptr[0]) << 24) | (static_cast<uint32_t>(ptr[1]) << 16) | (ptr[2] << 8) | ptr[3];
+        }
+
+        // DDP v1 packet with 10 or 14 byte header
+        inline bool parseDDP(const uint8_t *packet, size_t length, PacketInfo &info)
+        {
+            static constexpr uint8_t kVersionMask = 0xc0;
+            static constexpr uint8_t kVersion1 = 0x40;
+            static constexpr uint8_t kFlagTimecode = 0x10;
+            static constexpr uint8_t kFlagPush = 0x01;
+            static constexpr uint8_t kFlagQuery = 0x08;
+            static constexpr uint8_t kIdDisplay = 1;
+
+            if (length < 10 || (packet[0] & kVersionMask) != kVersion1 || (packet[0] & kFlagQuery) || packet[3] != kIdDisplay) {
+                return false;
+            }
+            uint8_t headerSize = (packet[0] & kFlagTimecode) ? 14 : 10;
+            uint16_t dataLength = readUint16BE(packet + 8);
+            if (length < headerSize + dataLength) {
+                return false;
+            }
+            info.protocol = Protocol::DDP;
+            info.universe = 0;
+            info.offset = readUint32BE(packet + 4);
+            info.data = packet + headerSize;
+            info.length = dataLength;
+            info.sync = packet[0] & kFlagPush;
+            return true;
+        }
+
+        // E1.31 data and synchronization packets
+        inline bool parseE131(const uint8_t *packet, size_t length, PacketInfo &info)
+        {
+            static constexpr uint32_t kVectorRootData = 0x00000004;
+            static constexpr uint32_t kVectorRootExtended = 0x00000008;
+            static constexpr uint32_t kVectorFramingData = 0x00000002;
+            static constexpr uint32_t kVectorFramingSync = 0x00000001;
+            static constexpr uint8_t kVectorDMP = 0x02;
+            static constexpr uint8_t kDataOffset = 126;
+
+            if (length < 49 || readUint16BE(packet) != 0x0010 || memcmp_P(packet + 4, PSTR("ASC-E1.17\0\0\0"), 12) != 0) {
+                return false;
+            }
+            uint32_t rootVector = readUint32BE(packet + 18);
+            uint32_t framingVector = readUint32BE(packet + 40);
+            if (rootVector == kVectorRootExtended && framingVector == kVectorFramingSync) {
+                info.protocol = Protocol::E131;
+                info.universe = readUint16BE(packet + 45);
+                info.offset = 0;
+                info.data = nullptr;
+                info.length = 0;
+                info.sync = true;
+                return true;
+            }
+            if (length < kDataOffset || rootVector != kVectorRootData || framingVector != kVectorFramingData || packet[117] != kVectorDMP || packet[125] != 0) {
+                return false;
+            }
+            uint16_t count = readUint16BE(packet + 123); // includes the start code
+            if (count == 0 || length < kDataOffset + count - 1u) {
+                return false;
+            }
+            info.protocol = Protocol::E131;
+            info.universe = readUint16BE(packet + 113);
+            info.offset = 0;
+            info.data = packet + kDataOffset;
+            info.length = count - 1;
+            info.sync = false;
+            return true;
+        }
+
+        inline bool isArtNet(const uint8_t *packet, size_t length)
+        {
+            return length >= 8 && memcmp_P(packet, PSTR("Art-Net\0"), 8) == 0;
+        }
+
+        // Art-Net OpDmx and OpSync packets
+        inline bool parseArtNet(const uint8_t *packet, size_t length, PacketInfo &info)
+        {
+            static constexpr uint16_t kOpDmx = 0x5000;
+            static constexpr uint16_t kOpSync = 0x5200;
+            static constexpr uint8_t kDataOffset = 18;
+
+            if (length < 14 || !isArtNet(packet, length)) {
+                return false;
+            }
+            uint16_t opCode = packet[8] | (packet[9] << 8);
+            if (opCode == kOpSync) {
+                info.protocol = Protocol::ARTNET;
+                info.universe = 0;
+                info.offset = 0;
+                info.data = nullptr;
+                info.length = 0;
+                info.sync = true;
+                return true;
+            }
+            if (opCode != kOpDmx || length < kDataOffset) {
+                return false;
+            }
+            uint16_t dataLength = readUint16BE(packet + 16);
+            if (length < kDataOffset + static_cast<size_t>(dataLength)) {
+                return false;
+            }
+            info.protocol = Protocol::ARTNET;
+            info.universe = packet[14] | ((packet[15] & 0x7f) << 8);
+            info.offset = 0;
+            info.data = packet + kDataOffset;
+            info.length = dataLength;
+            info.sync = false;
+            return true;
+        }
+
+        // detects the protocol
+        inline bool parse(const uint8_t *packet, size_t length, PacketInfo &info)
+        {
+            info.protocol = Protocol::NONE;
+            // the DDP header can start with 'A' (version 1, push flag)
+            if (isArtNet(packet, length)) {
+                return parseArtNet(packet, length, info);
+            }
+            if (length >= 16 && packet[0] == 0x00 && packet[1] == 0x10) {
+                return parseE131(packet, length, info);
+            }
+            return parseDDP(packet, length, info);
+        }
+
+        // returns true if _PixelType stores the colors in the same order as the packets
+        template<typename _PixelType>
+        constexpr bool isRGBLayout()
+        {
+            return std::is_same<typename _PixelType::type, RGBType>::value || std::is_same<typename _PixelType::type, CRGBType>::value;
+        }
+
+        // copy RGB data and convert it to _PixelType
+        // dst may be equal to src to convert the data in place
+        template<typename _PixelType>
+        void copyRGB(uint8_t *dst, const uint8_t *src, uint16_t numPixels)
+        {
+            if __CONSTEXPR17 (isRGBLayout<_PixelType>()) {
+                // same layout in memory
+                memmove(dst, src, numPixels * 3);
+            }
+            else {
+                auto pixels = reinterpret_cast<_PixelType *>(dst);
+                auto end = pixels + numPixels;
+                for(; pixels < end; pixels++, src += 3) {
+                    *pixels = _PixelType(src[0], src[1], src[2]);
+                }
+            }
+        }
+
+        // copy count channels of a single pixel starting at channel (0 = red, 1 = green, 2 = blue)
+        // used for pixels spanning two universes if channelsPerUniverse is not a multiple of 3
+        template<typename _PixelType>
+        void copyRGBChannels(uint8_t *dst, const uint8_t *src, uint8_t channel, uint8_t count)
+        {
+            auto &pixel = *reinterpret_cast<_PixelType *>(dst);
+            for(uint8_t i = channel; i < channel + count; i++, src++) {
+                switch(i) {
+                    case 0:
+                        pixel.red() = *src;
+                        break;
+                    case 1:
+                        pixel.green() = *src;
+                        break;
+                    default:
+                        pixel.blue() = *src;
+                        break;
+                }
+            }
+        }
+
+        class Stats {
+        public:
+            Stats() : _packets(0), _errors(0), _syncs(0), _totalMicros(0), _maxMicros(0) {}
+
+            void clear() {
+                *this = Stats();
+            }
+
+            uint32_t getPackets() const {
+                return _packets;
+            }
+
+            uint32_t getErrors() const {
+                return _errors;
+            }
+
+            uint32_t getSyncs() const {
+                return _syncs;
+            }
+
+            // average time to parse and copy a packet in microseconds
+            uint32_t getAvgMicros() const {
+                return _packets ? _totalMicros / _packets : 0;
+            }
+
+            uint32_t getMaxMicros() const {
+                return _maxMicros;
+            }
+
+            void add(bool success, bool sync, uint32_t micros) {
+                if (!success) {
+                    _errors++;
+                    return;
+                }
+                _packets++;
+                if (sync) {
+                    _syncs++;
+                }
+                _totalMicros += micros;
+                _maxMicros = std::max(_maxMicros, micros);
+            }
+
+        private:
+            uint32_t _packets;
+            uint32_t _errors;
+            uint32_t _syncs;
+            uint32_t _totalMicros;
+            uint32_t _maxMicros;
+        };
+
+        // maps the received data to the pixel buffers of one or more strips
+        // the data is copied and converted from RGB to the pixel type of the strip. if the pixel buffer is located
+        // inside the packet buffer (DataWrapper) and the layout is RGB, no data is copied. other layouts are
+        // converted in place
+        class Receiver {
+        public:
+            using CopyCallback = void (*)(uint8_t *dst, const uint8_t *src, uint16_t numPixels);
+            using CopyChannelsCallback = void (*)(uint8_t *dst, const uint8_t *src, uint8_t channel, uint8_t count);
+            using ShowCallback = void (*)(void *strip, uint8_t brightness);
+
+            struct Output {
+                void *strip;
+                uint8_t *pixels;
+                uint32_t start;
+                uint16_t numPixels;
+                CopyCallback copy;
+                CopyChannelsCallback copyChannels;
+                ShowCallback show;
+                // the pixel buffer can be used without copying if it is located inside the packet
+                bool rgbLayout;
+            };
+
+        public:
+            // channelsPerUniverse does not need to be a multiple of 3, pixels spanning two universes are
+            // updated channel by channel
+            Receiver(uint16_t firstUniverseE131 = 1, uint16_t channelsPerUniverse = 510, uint16_t firstUniverseArtNet = 0) :
+                _firstUniverseE131(firstUniverseE131),
+                _firstUniverseArtNet(firstUniverseArtNet),
+                _channelsPerUniverse(channelsPerUniverse),
+                _numOutputs(0),
+                _brightness(255),
+                _showWithoutSync(false),
+                _changed(false)
+            {
+            }
+
+            // add a strip starting at channel address start
+            template<typename _Strip>
+            bool addStrip(_Strip &strip, uint32_t start) {
+                static_assert(!std::is_base_of<SourceDataType, typename _Strip::data_type>::value, "strip requires a pixel buffer");
+                if (_numOutputs >= NEOPIXEL_NETWORK_MAX_OUTPUTS) {
+                    return false;
+                }
+                _outputs[_numOutputs++] = {
+                    &strip,
+                    reinterpret_cast<uint8_t *>(strip.data().data()),
+                    start,
+                    strip.getNumPixels(),
+                    copyRGB<typename _Strip::pixel_type>,
+                    copyRGBChannels<typename _Strip::pixel_type>,
+                    [](void *strip, uint8_t brightness) {
+                        auto &output = *reinterpret_cast<_Strip *>(strip);
+                        markDirtyRange(output.data(), 0, output.getNumPixels());
+                        output.show(brightness);
+                    },
+                    isRGBLayout<typename _Strip::pixel_type>()
+                };
+                return true;
+            }
+
+            void setBrightness(uint8_t brightness) {
+                _brightness = brightness;
+            }
+
+            // show the strips after each data packet instead of waiting for a sync packet or DDP push flag
+            void setShowWithoutSync(bool enable) {
+                _showWithoutSync = enable;
+            }
+
+            // parse a packet and copy the data to the strips
+            // returns false if the packet is invalid
+            bool process(const uint8_t *packet, size_t length) {
+                uint32_t start = micros();
+                PacketInfo info;
+                bool result = parse(packet, length, info);
+                if (result) {
+                    if (info.data) {
+                        _copy(info);
+                    }
+                    if (info.sync || _showWithoutSync) {
+                        _stats.add(true, info.sync, micros() - start);
+                        show();
+                        return true;
+                    }
+                }
+                _stats.add(result, false, micros() - start);
+                return result;
+            }
+
+            // show all strips that received data since the last call
+            void show() {
+                if (!_changed) {
+                    return;
+                }
+                _changed = false;
+                for(uint8_t i = 0; i < _numOutputs; i++) {
+                    _outputs[i].show(_outputs[i].strip, _brightness);
+                }
+            }
+
+            Stats &getStats() {
+                return _stats;
+            }
+
+        private:
+            void _copy(const PacketInfo &info) {
+                uint32_t address;
+                if (info.protocol == Protocol::DDP) {
+                    address = info.offset;
+                }
+                else {
+                    uint16_t firstUniverse = (info.protocol == Protocol::ARTNET) ? _firstUniverseArtNet : _firstUniverseE131;
+                    if (info.universe < firstUniverse) {
+                        return;
+                    }
+                    address = static_cast<uint32_t>(info.universe - firstUniverse) * _channelsPerUniverse;
+                }
+                uint32_t end = address + std::min<uint16_t>(info.length, info.protocol == Protocol::DDP ? info.length : _channelsPerUniverse);
+                for(uint8_t i = 0; i < _numOutputs; i++) {
+                    auto &output = _outputs[i];
+                    uint32_t outputEnd = output.start + output.numPixels * 3;
+                    uint32_t from = std::max(address, output.start);
+                    uint32_t to = std::min(end, outputEnd);
+                    if (from >= to) {
+                        continue;
+                    }
+                    // the first pixel continues in this packet
+                    uint8_t channel = (from - output.start) % 3;
+                    if (channel) {
+                        uint8_t count = std::min<uint32_t>(3 - channel, to - from);
+                        output.copyChannels(output.pixels + (from - output.start - channel), info.data + (from - address), channel, count);
+                        from += count;
+                    }
+                    // whole pixels
+                    uint16_t numPixels = (to - from) / 3;
+                    if (numPixels) {
+                        auto dst = output.pixels + (from - output.start);
+                        auto src = info.data + (from - address);
+                        // other layouts are converted in place
+                        if (dst != src || !output.rgbLayout) {
+                            output.copy(dst, src, numPixels);
+                        }
+                        from += numPixels * 3;
+                    }
+                    // the last pixel continues in the next packet
+                    if (from < to) {
+                        output.copyChannels(output.pixels + (from - output.start), info.data + (from - address), 0, to - from);
+                    }
+                    _changed = true;
+                }
+            }
+
+        private:
+            Output _outputs[NEOPIXEL_NETWORK_MAX_OUTPUTS];
+            Stats _stats;
+            uint16_t _firstUniverseE131;
+            uint16_t _firstUniverseArtNet;
+            uint16_t _channelsPerUniverse;
+            uint8_t _numOutputs;
+            uint8_t _brightness;
+            bool _showWithoutSync;
+            bool _changed;
+        };
+
+    }
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
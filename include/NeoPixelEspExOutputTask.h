@@ -0,0 +1,240 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+#ifndef NEOPIXEL_OUTPUT_TASK_STACK_SIZE
+#   define NEOPIXEL_OUTPUT_TASK_STACK_SIZE 2048
+#endif
+
+#ifndef NEOPIXEL_OUTPUT_TASK_PRIORITY
+#   define NEOPIXEL_OUTPUT_TASK_PRIORITY 5
+#endif
+
+namespace NeoPixelEx {
+
+    // lock-free single producer, single consumer queue that always returns the latest frame
+    //
+    // the queue uses 3 buffers. the producer owns one buffer to render the next frame, the consumer owns the
+    // frame that is being sent and the third buffer holds the latest frame that has not been sent yet. push()
+    // and pop() swap their buffer with the third buffer. if the producer is faster than the consumer, the
+    // pending frame is replaced and counted as dropped. neither side is ever blocked
+    template<typename _Frame>
+    class FrameQueue {
+    public:
+        using frame_type = _Frame;
+
+    public:
+        FrameQueue() : _back(0), _front(1), _dropped(0), _middle(2) {}
+
+        // buffer for the next frame, only accessed by the producer
+        frame_type &back() {
+            return _buffers[_back];
+        }
+
+        // publish the frame returned by back(). the next frame is rendered into a different buffer
+        // which does not contain the previous frame
+        // returns false if a frame that has not been sent yet was replaced
+        bool push() {
+            uint8_t prev = _middle.exchange(_back | kNewFrame, std::memory_order_acq_rel);
+            _back = prev & kIndexMask;
+            if (prev & kNewFrame) {
+                _dropped++;
+                return false;
+            }
+            return true;
+        }
+
+        // returns the latest frame or nullptr if no frame has been pushed since the last call
+        // the frame is owned by the consumer until the next call
+        frame_type *pop() {
+            if (!(_middle.load(std::memory_order_acquire) & kNewFrame)) {
+                return nullptr;
+            }
+            // only the producer sets kNewFrame, the exchange always returns a new frame
+            _front = _middle.exchange(_front, std::memory_order_acq_rel) & kIndexMask;
+            return &_buffers[_front];
+        }
+
+        // returns true if a frame is waiting
+        bool available() const {
+            return _middle.load(std::memory_order_acquire) & kNewFrame;
+        }
+
+        // frames that have been replaced before being sent
+        uint32_t getDropped() const {
+            return _dropped;
+        }
+
+    private:
+        static constexpr uint8_t kNewFrame = 0x80;
+        static constexpr uint8_t kIndexMask = 0x03;
+
+        frame_type _buffers[3];
+        uint8_t _back;
+        uint8_t _front;
+        uint32_t _dropped;
+        std::atomic<uint8_t> _middle;
+    };
+
+    // sends the frames of a strip from a dedicated task
+    //
+    // the application renders into frame() and passes it to the output task with submit(). the task sends the
+    // latest frame. if rendering is faster than sending, older frames are dropped. the pixel buffer of the strip is
+    // not used, the frames are sent with Strip::showPixels() and the output backend of the strip
+    //
+    // the queue and process() are portable, the task is created on ESP32 only. on other platforms, process() can
+    // be called from loop()
+    template<typename _Strip>
+    class OutputTask {
+    public:
+        using strip_type = _Strip;
+        using pixel_type = typename _Strip::pixel_type;
+
+        struct Frame {
+            alignas(4) std::array<pixel_type, _Strip::size()> pixels;
+            uint8_t brightness;
+            uint32_t time;
+
+            pixel_type *data() {
+                return pixels.data();
+            }
+
+            static constexpr uint16_t size() {
+                return _Strip::size();
+            }
+        };
+
+        using queue_type = FrameQueue<Frame>;
+
+    public:
+        OutputTask(strip_type &strip) :
+            _strip(strip),
+            _frames(0),
+            _maxLatency(0)
+            #if ESP32
+                , _task(nullptr),
+                _running(false)
+            #endif
+        {
+        }
+
+        ~OutputTask() {
+            #if ESP32
+                end();
+            #endif
+        }
+
+        // buffer for the next frame. the buffer does not contain the previous frame
+        Frame &frame() {
+            return _queue.back();
+        }
+
+        // pass the frame to the output task
+        // returns false if the previous frame has been dropped
+        bool submit(uint8_t brightness = 255) {
+            auto &frame = _queue.back();
+            frame.brightness = brightness;
+            frame.time = micros();
+            bool result = _queue.push();
+            #if ESP32
+                if (_task) {
+                    xTaskNotifyGive(_task);
+                }
+            #endif
+            return result;
+        }
+
+        // send the latest frame, returns false if there was no new frame
+        // must be called from a single task only
+        bool process() {
+            auto frame = _queue.pop();
+            if (!frame) {
+                return false;
+            }
+            _maxLatency = std::max<uint32_t>(_maxLatency, micros() - frame->time);
+            _strip.showPixels(frame->data(), frame->brightness);
+            _frames++;
+            return true;
+        }
+
+        // frames that have been sent
+        uint32_t getFrames() const {
+            return _frames;
+        }
+
+        // frames that have been replaced by a newer frame before being sent
+        uint32_t getDropped() const {
+            return _queue.getDropped();
+        }
+
+        // max. time between submit() and sending the frame in microseconds
+        uint32_t getMaxLatency() const {
+            return _maxLatency;
+        }
+
+    #if ESP32
+
+        // create the output task pinned to core
+        bool begin(uint8_t core = 0, UBaseType_t priority = NEOPIXEL_OUTPUT_TASK_PRIORITY, uint32_t stackSize = NEOPIXEL_OUTPUT_TASK_STACK_SIZE) {
+            if (_task) {
+                return true;
+            }
+            _running = true;
+            if (xTaskCreatePinnedToCore(_taskMain, "neopixel", stackSize, this, priority, &_task, core) != pdPASS) {
+                _running = false;
+                _task = nullptr;
+                return false;
+            }
+            return true;
+        }
+
+        // stop the task after the current frame has been sent
+        void end() {
+            if (!_task) {
+                return;
+            }
+            _running = false;
+            xTaskNotifyGive(_task);
+            while (_task) {
+                delay(1);
+            }
+        }
+
+    private:
+        static void _taskMain(void *arg) {
+            auto &self = *reinterpret_cast<OutputTask *>(arg);
+            while (self._running) {
+                ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                while (self._running && self.process()) {
+                }
+            }
+            self._task = nullptr;
+            vTaskDelete(nullptr);
+        }
+
+    #endif
+
+    private:
+        strip_type &_strip;
+        queue_type _queue;
+        uint32_t _frames;
+        uint32_t _maxLatency;
+        #if ESP32
+            TaskHandle_t volatile _task;
+            volatile bool _running;
+        #endif
+    };
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
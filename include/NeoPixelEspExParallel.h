@@ -0,0 +1,396 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#if ESP32
+#   include <soc/i2s_struct.h>
+#   include <soc/gpio_sig_map.h>
+#   include <driver/periph_ctrl.h>
+#   include <esp_intr_alloc.h>
+#   if defined(HAS_ESP_IDF_4)
+#       include <esp32/rom/lldesc.h>
+#       include <esp32/rom/gpio.h>
+#   else
+#       include <rom/lldesc.h>
+#       include <rom/gpio.h>
+#   endif
+#endif
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+// number of bytes per strip in each DMA buffer
+#ifndef NEOPIXEL_PARALLEL_CHUNK_SIZE
+#   define NEOPIXEL_PARALLEL_CHUNK_SIZE 16
+#endif
+
+// number of DMA buffers
+#ifndef NEOPIXEL_PARALLEL_NUM_BUFFERS
+#   define NEOPIXEL_PARALLEL_NUM_BUFFERS 4
+#endif
+
+namespace NeoPixelEx {
+
+    // parallel output of up to 16 strips with the same length, pixel type and chipset
+    //
+    // each bit is sent as 3 samples of 16 bit, one bit per strip. the first sample is high for all strips, the second
+    // contains the data and the third sample is low. the data is transposed into bit slices in small chunks while
+    // the previous chunks are sent
+    namespace Parallel {
+
+        static constexpr uint8_t kSamplesPerBit = 3;
+        static constexpr uint8_t kSamplesPerByte = kSamplesPerBit * 8;
+
+        // transpose 8 bytes of 8 strips into 8 bit slices
+        // out[0] contains bit 7 of each input byte, bit n of each slice belongs to in[n]
+        __attribute__((always_inline)) inline void transpose8(const uint8_t *in, uint8_t *out) {
+            // the first row is stored in the MSB
+            uint32_t x = (in[7] << 24) | (in[6] << 16) | (in[5] << 8) | in[4];
+            uint32_t y = (in[3] << 24) | (in[2] << 16) | (in[1] << 8) | in[0];
+            uint32_t t;
+
+            t = (x ^ (x >> 7)) & 0x00aa00aa;
+            x = x ^ t ^ (t << 7);
+            t = (y ^ (y >> 7)) & 0x00aa00aa;
+            y = y ^ t ^ (t << 7);
+
+            t = (x ^ (x >> 14)) & 0x0000cccc;
+            x = x ^ t ^ (t << 14);
+            t = (y ^ (y >> 14)) & 0x0000cccc;
+            y = y ^ t ^ (t << 14);
+
+            t = (x & 0xf0f0f0f0) | ((y >> 4) & 0x0f0f0f0f);
+            y = ((x << 4) & 0xf0f0f0f0) | (y & 0x0f0f0f0f);
+            x = t;
+
+            out[0] = x >> 24;
+            out[1] = x >> 16;
+            out[2] = x >> 8;
+            out[3] = x;
+            out[4] = y >> 24;
+            out[5] = y >> 16;
+            out[6] = y >> 8;
+            out[7] = y;
+        }
+
+        // samples for one byte of _NumLanes strips. in must contain 16 bytes
+        // the I2S unit sends the 16 bit halves of each 32 bit word in reverse order, dst must be 32 bit aligned
+        template<uint8_t _NumLanes = 16>
+        __attribute__((always_inline)) inline void encodeByte(uint16_t *dst, const uint8_t *in, uint16_t mask) {
+            uint8_t low[8];
+            uint8_t high[8] = {};
+            transpose8(in, low);
+            if __CONSTEXPR17 (_NumLanes > 8) {
+                transpose8(in + 8, high);
+            }
+            for(uint8_t i = 0; i < 8; i++) {
+                uint8_t index = i * kSamplesPerBit;
+                dst[index ^ 1] = mask;
+                dst[(index + 1) ^ 1] = (low[i] | (high[i] << 8)) & mask;
+                dst[(index + 2) ^ 1] = 0;
+            }
+        }
+
+        // reads the bytes of all strips with brightness and color order applied and creates the samples
+        template<uint8_t _NumLanes, uint16_t _NumPixels, typename _PixelType>
+        class Encoder {
+        public:
+            using pixel_type = _PixelType;
+
+            static constexpr uint8_t kNumLanes = _NumLanes;
+            static constexpr uint16_t kNumBytes = _NumPixels * sizeof(pixel_type);
+
+            static_assert(_NumLanes >= 1 && _NumLanes <= 16, "1-16 lanes supported");
+
+        public:
+            Encoder() : _mask(0), _pos(0), _brightness(0), _lanes{} {}
+
+            // pixels must provide _NumPixels, nullptr keeps the output low
+            void setLane(uint8_t lane, const pixel_type *pixels) {
+                _lanes[lane] = reinterpret_cast<const uint8_t *>(pixels);
+                _mask = pixels ? (_mask | (1U << lane)) : (_mask & ~(1U << lane));
+            }
+
+            // start a new frame, brightness is 0-255
+            void reset(uint8_t brightness) {
+                _pos = 0;
+                _brightness = brightness ? brightness + 1 : 0;
+                _order = PixelOrder<pixel_type>();
+            }
+
+            bool available() const {
+                return _pos < kNumBytes;
+            }
+
+            // create numBytes * kSamplesPerByte samples. samples after the end of the frame are 0
+            // called from the interrupt handler
+            __attribute__((always_inline)) inline void encode(uint16_t *dst, uint16_t numBytes) {
+                uint8_t in[16] = {};
+                for(; numBytes; numBytes--) {
+                    if (_pos >= kNumBytes) {
+                        std::fill_n(dst, numBytes * kSamplesPerByte, 0);
+                        return;
+                    }
+                    for(uint8_t lane = 0; lane < kNumLanes; lane++) {
+                        if (_lanes[lane]) {
+                            in[lane] = (_order.get(_lanes[lane] + _pos) * _brightness) >> 8;
+                        }
+                    }
+                    _order.next();
+                    _pos++;
+                    encodeByte<_NumLanes>(dst, in, _mask);
+                    dst += kSamplesPerByte;
+                }
+            }
+
+            uint16_t getMask() const {
+                return _mask;
+            }
+
+        private:
+            uint16_t _mask;
+            uint16_t _pos;
+            uint16_t _brightness;
+            PixelOrder<pixel_type> _order;
+            const uint8_t *_lanes[16];
+        };
+
+        // I2S clock divider, the sample rate is 80MHz / (kDivNum + kDivB / kDivA) / 2 for 3 samples per bit
+        template<typename _Chipset>
+        struct ClockDivider {
+            // 2 cycles of 80MHz in pico seconds
+            static constexpr uint32_t kPicosPerDiv = 25000;
+            // time per sample in pico seconds
+            static constexpr uint32_t kPeriod = _Chipset::kNanosPeriod * 1000UL / kSamplesPerBit;
+            static constexpr uint8_t kDivNum = kPeriod / kPicosPerDiv;
+            static constexpr uint32_t kRemainder = kPeriod % kPicosPerDiv;
+
+            static constexpr uint32_t gcd(uint32_t a, uint32_t b) {
+                return b ? gcd(b, a % b) : a;
+            }
+
+            static constexpr uint32_t kGcd = gcd(kPicosPerDiv, kRemainder ? kRemainder : kPicosPerDiv);
+            // a and b are limited to 6 bit
+            static constexpr uint8_t kDivA = (kPicosPerDiv / kGcd <= 63) ? kPicosPerDiv / kGcd : 63;
+            static constexpr uint8_t kDivB = (kPicosPerDiv / kGcd <= 63) ? kRemainder / kGcd : (kRemainder * 63 + kPicosPerDiv / 2) / kPicosPerDiv;
+
+            static_assert(kDivNum >= 2 && kDivNum <= 255, "period of the chipset cannot be used with I2S");
+        };
+
+    }
+
+    #if ESP32
+
+        // output for up to 16 strips using I2S1 in LCD mode
+        //
+        // the pixel buffers are read by the interrupt handler while the frame is sent and must not be modified
+        // until isBusy() returns false
+        //
+        // NeoPixelEx::I2SParallel<16, 500, NeoPixelEx::GRB> output;
+        // output.setLane(0, 12, strip1.data());
+        // output.setLane(1, 13, strip2.data());
+        // output.begin();
+        // output.show(128);
+        template<uint8_t _NumLanes, uint16_t _NumPixels, typename _PixelType = GRB, typename _Chipset = TimingsWS2812>
+        class I2SParallel {
+        public:
+            using pixel_type = _PixelType;
+            using encoder_type = Parallel::Encoder<_NumLanes, _NumPixels, _PixelType>;
+            using clock_type = Parallel::ClockDivider<_Chipset>;
+
+            static constexpr uint16_t kChunkSize = NEOPIXEL_PARALLEL_CHUNK_SIZE;
+            static constexpr uint8_t kNumBuffers = NEOPIXEL_PARALLEL_NUM_BUFFERS;
+            static constexpr uint16_t kBufferSize = kChunkSize * Parallel::kSamplesPerByte * sizeof(uint16_t);
+            static constexpr uint16_t kDataChunks = (encoder_type::kNumBytes + kChunkSize - 1) / kChunkSize;
+            // chunks of zeros for the reset, the output stops while the last buffer is sent
+            static constexpr uint16_t kResetChunks = (_Chipset::kResetDelay * 1000UL + _Chipset::kNanosPeriod * 8 * kChunkSize - 1) / (_Chipset::kNanosPeriod * 8 * kChunkSize) + 1;
+
+            static_assert(kBufferSize <= 4092, "NEOPIXEL_PARALLEL_CHUNK_SIZE too big");
+            static_assert(kNumBuffers >= 2, "at least 2 buffers required");
+
+        public:
+            I2SParallel() : _pins{}, _busy(false), _interrupt(nullptr) {}
+
+            ~I2SParallel() {
+                end();
+            }
+
+            // pixels must provide _NumPixels pixels
+            void setLane(uint8_t lane, uint8_t pin, const pixel_type *pixels) {
+                _pins[lane] = pin;
+                _encoder.setLane(lane, pixels);
+            }
+
+            void begin() {
+                periph_module_enable(PERIPH_I2S1_MODULE);
+                auto &i2s = I2S1;
+
+                i2s.conf.tx_reset = 1;
+                i2s.conf.tx_reset = 0;
+                i2s.conf.tx_fifo_reset = 1;
+                i2s.conf.tx_fifo_reset = 0;
+                i2s.lc_conf.out_rst = 1;
+                i2s.lc_conf.out_rst = 0;
+                i2s.lc_conf.ahbm_rst = 1;
+                i2s.lc_conf.ahbm_rst = 0;
+
+                // LCD mode with 16 bit samples
+                i2s.conf2.val = 0;
+                i2s.conf2.lcd_en = 1;
+                i2s.sample_rate_conf.val = 0;
+                i2s.sample_rate_conf.tx_bits_mod = 16;
+                i2s.sample_rate_conf.tx_bck_div_num = 1;
+                i2s.clkm_conf.val = 0;
+                i2s.clkm_conf.clka_en = 0;
+                i2s.clkm_conf.clkm_div_num = clock_type::kDivNum;
+                i2s.clkm_conf.clkm_div_a = clock_type::kDivA;
+                i2s.clkm_conf.clkm_div_b = clock_type::kDivB;
+                i2s.fifo_conf.val = 0;
+                i2s.fifo_conf.tx_fifo_mod_force_en = 1;
+                i2s.fifo_conf.tx_fifo_mod = 1;
+                i2s.fifo_conf.tx_data_num = 32;
+                i2s.fifo_conf.dscr_en = 1;
+                i2s.conf1.val = 0;
+                i2s.conf1.tx_stop_en = 0;
+                i2s.conf1.tx_pcm_bypass = 1;
+                i2s.conf_chan.val = 0;
+                i2s.conf_chan.tx_chan_mod = 1;
+                i2s.timing.val = 0;
+                i2s.lc_conf.out_eof_mode = 1;
+
+                // in 16 bit mode, the data is available on DATA_OUT8-23
+                for(uint8_t lane = 0; lane < _NumLanes; lane++) {
+                    if (_encoder.getMask() & (1U << lane)) {
+                        gpio_set_direction(gpio_num_t(_pins[lane]), GPIO_MODE_OUTPUT);
+                        gpio_matrix_out(_pins[lane], I2S1O_DATA_OUT8_IDX + lane, false, false);
+                    }
+                }
+
+                // ring of DMA buffers
+                for(uint8_t i = 0; i < kNumBuffers; i++) {
+                    auto &desc = _descriptors[i];
+                    desc.size = kBufferSize;
+                    desc.length = kBufferSize;
+                    desc.buf = reinterpret_cast<uint8_t *>(_buffers[i]);
+                    desc.owner = 1;
+                    desc.sosf = 0;
+                    desc.offset = 0;
+                    desc.eof = 1;
+                    desc.empty = reinterpret_cast<uint32_t>(&_descriptors[(i + 1) % kNumBuffers]);
+                }
+
+                if (!_interrupt) {
+                    esp_intr_alloc(ETS_I2S1_INTR_SOURCE, ESP_INTR_FLAG_IRAM | ESP_INTR_FLAG_LEVEL3, _isr, this, &_interrupt);
+                }
+                i2s.int_clr.val = 0xffffffff;
+                i2s.int_ena.val = 0;
+                i2s.int_ena.out_eof = 1;
+            }
+
+            void end() {
+                if (!_interrupt) {
+                    return;
+                }
+                wait();
+                esp_intr_free(_interrupt);
+                _interrupt = nullptr;
+            }
+
+            // start sending the frame and return immediately
+            void show(uint8_t brightness = 255) {
+                wait();
+                _context.waitRefreshTime(_Chipset::getMinDisplayPeriod());
+
+                _encoder.reset(brightness);
+                for(uint8_t i = 0; i < kNumBuffers; i++) {
+                    _encoder.encode(_buffers[i], kChunkSize);
+                }
+                _done = 0;
+                _busy = true;
+
+                auto &i2s = I2S1;
+                i2s.conf.tx_start = 0;
+                i2s.conf.tx_reset = 1;
+                i2s.conf.tx_reset = 0;
+                i2s.conf.tx_fifo_reset = 1;
+                i2s.conf.tx_fifo_reset = 0;
+                i2s.lc_conf.out_rst = 1;
+                i2s.lc_conf.out_rst = 0;
+                i2s.int_clr.val = 0xffffffff;
+                i2s.out_link.addr = reinterpret_cast<uint32_t>(&_descriptors[0]);
+                i2s.out_link.start = 1;
+                i2s.conf.tx_start = 1;
+
+                #if NEOPIXEL_HAVE_STATS
+                    _context.getStats().increment(true);
+                #endif
+            }
+
+            // returns true while the frame is sent
+            bool isBusy() const {
+                return _busy;
+            }
+
+            void wait() {
+                while (_busy) {
+                    std::atomic_signal_fence(std::memory_order_seq_cst);
+                }
+            }
+
+            Context &getContext() {
+                return _context;
+            }
+
+            #if NEOPIXEL_HAVE_STATS
+                Stats &getStats() {
+                    return _context.getStats();
+                }
+            #endif
+
+        private:
+            // each interrupt refills the buffer that has been sent with the chunk after the buffers that are queued
+            static void IRAM_ATTR _isr(void *arg) {
+                auto &self = *reinterpret_cast<I2SParallel *>(arg);
+                auto &i2s = I2S1;
+                if (!i2s.int_st.out_eof) {
+                    i2s.int_clr.val = i2s.int_st.val;
+                    return;
+                }
+                i2s.int_clr.val = i2s.int_st.val;
+                if (!self._busy) {
+                    return;
+                }
+                uint16_t done = ++self._done;
+                if (done >= kDataChunks + kResetChunks) {
+                    i2s.conf.tx_start = 0;
+                    i2s.out_link.stop = 1;
+                    self._context.setLastDisplayTime(micros());
+                    self._busy = false;
+                    return;
+                }
+                self._encoder.encode(self._buffers[(done - 1) % kNumBuffers], kChunkSize);
+            }
+
+        private:
+            encoder_type _encoder;
+            uint8_t _pins[_NumLanes];
+            alignas(4) uint16_t _buffers[kNumBuffers][kChunkSize * Parallel::kSamplesPerByte];
+            lldesc_t _descriptors[kNumBuffers];
+            volatile uint16_t _done;
+            volatile bool _busy;
+            intr_handle_t _interrupt;
+            Context _context;
+        };
+
+    #endif
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
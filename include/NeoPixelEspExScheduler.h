@@ -0,0 +1,252 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+// default max. time in microseconds that Scheduler::run() blocks
+#ifndef NEOPIXEL_SCHEDULER_MAX_BLOCKING_TIME
+#   define NEOPIXEL_SCHEDULER_MAX_BLOCKING_TIME 5000
+#endif
+
+namespace NeoPixelEx {
+
+    // sends multiple strips spread over several calls of run() instead of calling show() back to back
+    //
+    // each strip has a target fps and is sent if it has been modified and its deadline has been reached. run() sends
+    // the strips ordered by deadline until the wire time of the next strip does not fit into the max. blocking time.
+    // smaller strips with a later deadline are sent if they still fit. a strip that has been passed over keeps its
+    // early deadline and is sent first during the next call. a single strip that exceeds the max. blocking time is
+    // sent alone
+    //
+    // the deadline of a strip that has not been modified moves with the time. the lateness is the time between the
+    // deadline and sending the frame and is added to the stats of the strip
+    //
+    // the wire time is estimated from the chipset and the number of pixels. run() does not measure any time after it
+    // has started and the scheduling decisions depend on the argument now only
+    template<uint8_t _MaxStrips = 8>
+    class Scheduler {
+    public:
+        static constexpr uint8_t kMaxStrips = _MaxStrips;
+        static constexpr uint8_t kInvalidIndex = 0xff;
+
+        static_assert(kMaxStrips <= 32, "max. 32 strips");
+
+        struct Entry {
+            void *strip;
+            void (*show)(void *strip, uint8_t brightness);
+            bool (*isDirty)(const void *strip);
+            #if NEOPIXEL_HAVE_STATS
+                Stats *stats;
+            #endif
+            uint32_t wireTime;
+            uint32_t period;
+            uint32_t deadline;
+            uint8_t brightness;
+            bool pending;
+        };
+
+    public:
+        Scheduler(uint32_t maxBlockingTime = NEOPIXEL_SCHEDULER_MAX_BLOCKING_TIME) :
+            _maxBlockingTime(maxBlockingTime),
+            _count(0),
+            _next(0)
+        {
+        }
+
+        // add a strip with a target of fps frames per second. the wire time is the frame time plus the reset delay
+        // of the chipset, the second version can be used for chipsets without timings
+        // returns false if there are already kMaxStrips strips
+        template<typename _Strip>
+        bool add(_Strip &strip, uint16_t fps, uint32_t now = micros()) {
+            return add(strip, fps, _Strip::getFrameTime() + _Strip::chipset_type::kResetDelay, now);
+        }
+
+        template<typename _Strip>
+        bool add(_Strip &strip, uint16_t fps, uint32_t wireTime, uint32_t now) {
+            if (_count >= kMaxStrips || !fps) {
+                return false;
+            }
+            auto &entry = _entries[_count++];
+            entry.strip = &strip;
+            entry.show = _show<_Strip>;
+            entry.isDirty = _isDirty<_Strip>;
+            #if NEOPIXEL_HAVE_STATS
+                entry.stats = &strip.getStats();
+            #endif
+            entry.wireTime = wireTime;
+            entry.period = 1000000UL / fps;
+            entry.deadline = now;
+            entry.brightness = 255;
+            entry.pending = true;
+            return true;
+        }
+
+        void remove(const void *strip) {
+            auto index = _find(strip);
+            if (index != kInvalidIndex) {
+                _entries[index] = _entries[--_count];
+            }
+        }
+
+        // the strip is sent with this brightness. a different brightness marks the strip as modified
+        void setBrightness(const void *strip, uint8_t brightness) {
+            auto index = _find(strip);
+            if (index != kInvalidIndex && _entries[index].brightness != brightness) {
+                _entries[index].brightness = brightness;
+                _entries[index].pending = true;
+            }
+        }
+
+        void setMaxBlockingTime(uint32_t maxBlockingTime) {
+            _maxBlockingTime = maxBlockingTime;
+        }
+
+        uint32_t getMaxBlockingTime() const {
+            return _maxBlockingTime;
+        }
+
+        uint8_t size() const {
+            return _count;
+        }
+
+        const Entry &operator[](uint8_t index) const {
+            return _entries[index];
+        }
+
+        // send the strips that are due at the time now in microseconds
+        // returns the estimated time in microseconds that has been spent sending
+        uint32_t run(uint32_t now = micros());
+
+        // time until the next modified strip is due in microseconds, 0 if a strip is due already and ~0 if no strip
+        // has been modified
+        uint32_t getTimeUntilNext(uint32_t now = micros()) const;
+
+    private:
+        template<typename _Strip>
+        static void _show(void *strip, uint8_t brightness) {
+            reinterpret_cast<_Strip *>(strip)->show(brightness);
+        }
+
+        template<typename _Strip>
+        static bool _isDirty(const void *strip) {
+            return _isDirty(reinterpret_cast<const _Strip *>(strip)->data(), std::is_base_of<DirtyTracking, typename _Strip::data_type>());
+        }
+
+        template<typename _DataType>
+        static bool _isDirty(const _DataType &data, std::true_type) {
+            return data.isDirty();
+        }
+
+        // without tracking, the strip is sent with the target fps
+        template<typename _DataType>
+        static bool _isDirty(const _DataType &, std::false_type) {
+            return true;
+        }
+
+        uint8_t _find(const void *strip) const {
+            for(uint8_t i = 0; i < _count; i++) {
+                if (_entries[i].strip == strip) {
+                    return i;
+                }
+            }
+            return kInvalidIndex;
+        }
+
+        // the modified strip with the earliest deadline that fits into remaining. strips with the same deadline are
+        // selected round robin starting at _next
+        uint8_t _select(uint32_t now, uint32_t remaining, uint32_t done) const;
+
+    private:
+        Entry _entries[kMaxStrips];
+        uint32_t _maxBlockingTime;
+        uint8_t _count;
+        uint8_t _next;
+    };
+
+    template<uint8_t _MaxStrips>
+    uint32_t Scheduler<_MaxStrips>::run(uint32_t now)
+    {
+        // deadlines of unmodified strips are moved to now. a strip that is modified before the next call is due
+        // immediately and the lateness starts with this call
+        for(uint8_t i = 0; i < _count; i++) {
+            auto &entry = _entries[i];
+            if (!entry.pending) {
+                entry.pending = entry.isDirty(entry.strip);
+            }
+            if (!entry.pending && static_cast<int32_t>(now - entry.deadline) > 0) {
+                entry.deadline = now;
+            }
+        }
+
+        uint32_t elapsed = 0;
+        uint32_t done = 0;
+        uint8_t index;
+        // the first strip is sent even if it exceeds the max. blocking time
+        while (elapsed < _maxBlockingTime && (index = _select(now + elapsed, elapsed ? _maxBlockingTime - elapsed : ~0U, done)) != kInvalidIndex) {
+            auto &entry = _entries[index];
+            uint32_t start = now + elapsed;
+            #if NEOPIXEL_HAVE_STATS
+                entry.stats->addLateness(start - entry.deadline);
+            #endif
+            entry.show(entry.strip, entry.brightness);
+            entry.pending = false;
+            elapsed += entry.wireTime;
+            done |= 1UL << index;
+
+            // keep the frame rate if the strip is less than a period late, otherwise start again with the current time
+            entry.deadline += entry.period;
+            if (static_cast<int32_t>(start - entry.deadline) > 0) {
+                entry.deadline = start + entry.period;
+            }
+            _next = index + 1 < _count ? index + 1 : 0;
+        }
+        return elapsed;
+    }
+
+    template<uint8_t _MaxStrips>
+    uint8_t Scheduler<_MaxStrips>::_select(uint32_t now, uint32_t remaining, uint32_t done) const
+    {
+        uint8_t result = kInvalidIndex;
+        int32_t earliest = 0;
+        for(uint8_t n = 0; n < _count; n++) {
+            uint8_t i = (_next + n) % _count;
+            auto &entry = _entries[i];
+            if ((done & (1UL << i)) || !entry.pending || entry.wireTime > remaining) {
+                continue;
+            }
+            // time since the deadline, negative if it has not been reached yet
+            int32_t overdue = now - entry.deadline;
+            if (overdue >= 0 && (result == kInvalidIndex || overdue > earliest)) {
+                result = i;
+                earliest = overdue;
+            }
+        }
+        return result;
+    }
+
+    template<uint8_t _MaxStrips>
+    uint32_t Scheduler<_MaxStrips>::getTimeUntilNext(uint32_t now) const
+    {
+        uint32_t result = ~0U;
+        for(uint8_t i = 0; i < _count; i++) {
+            auto &entry = _entries[i];
+            if (entry.pending || entry.isDirty(entry.strip)) {
+                int32_t diff = entry.deadline - now;
+                result = std::min<uint32_t>(result, diff > 0 ? diff : 0);
+            }
+        }
+        return result;
+    }
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
@@ -0,0 +1,307 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+namespace NeoPixelEx {
+
+    // binary protocol to stream pixel data over a serial port
+    //
+    // each command is sent as packet, all values are little endian
+    //
+    // uint8_t  'N'
+    // uint8_t  'X'
+    // uint8_t  command
+    // uint16_t length of the payload
+    // uint8_t  payload[length]
+    // uint8_t  checksum, the sum of command, length, payload and checksum must be 0xff
+    //
+    // kFill     uint16_t offset, uint16_t count, RGB color
+    // kPixels   uint16_t offset, RGB color for each pixel
+    // kPalette  uint8_t first index, RGB color for each palette entry
+    // kIndexed  uint16_t offset, palette index for each pixel
+    // kCommit   show the frame
+    //
+    // the payload is written to the pixel buffer while it is received. if any packet had an invalid checksum,
+    // the next commit returns Result::ERROR and the host has to resend all changed pixels. Result::ERROR is only
+    // returned for commits, the host receives a single kAck or kNak for each frame
+    // scripts/serial_stream.py sends raw RGB frames as deltas
+    namespace SerialProtocol {
+
+        static constexpr uint8_t kMagic1 = 'N';
+        static constexpr uint8_t kMagic2 = 'X';
+
+        static constexpr uint8_t kFill = 0x01;
+        static constexpr uint8_t kPixels = 0x02;
+        static constexpr uint8_t kPalette = 0x03;
+        static constexpr uint8_t kIndexed = 0x04;
+        static constexpr uint8_t kCommit = 0x05;
+
+        // response after kCommit
+        static constexpr uint8_t kAck = 'A';
+        static constexpr uint8_t kNak = 'E';
+
+        enum class Result : uint8_t {
+            NONE,
+            COMMIT,
+            ERROR,
+        };
+
+        // incremental parser, the data can be passed byte by byte or in chunks of any size
+        // invalid input never writes outside the pixel buffer or the palette
+        // a parser created from a data type with dirty tracking marks the pixels it writes
+        template<typename _PixelType = GRB, uint16_t _PaletteSize = 16>
+        class Parser {
+        public:
+            using pixel_type = _PixelType;
+
+            static constexpr uint16_t kPaletteSize = _PaletteSize;
+
+        public:
+            Parser(pixel_type *pixels, uint16_t numPixels) :
+                _pixels(pixels),
+                _numPixels(numPixels),
+                _state(State::MAGIC1),
+                _error(false),
+                _frames(0),
+                _errors(0),
+                _palette{}
+                #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                    , _dirty(nullptr)
+                #endif
+            {
+            }
+
+            template<typename _Ta>
+            Parser(_Ta &data) : Parser(data.data(), data.size()) {
+                #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                    _dirty = getDirtyTracking(data);
+                #endif
+            }
+
+            // returns Result::COMMIT if a frame is complete and can be displayed and Result::ERROR if the frame
+            // has to be sent again
+            Result feed(uint8_t byte) {
+                switch(_state) {
+                    case State::MAGIC1:
+                        if (byte == kMagic1) {
+                            _state = State::MAGIC2;
+                        }
+                        break;
+                    case State::MAGIC2:
+                        _state = (byte == kMagic2) ? State::COMMAND : (byte == kMagic1) ? State::MAGIC2 : State::MAGIC1;
+                        break;
+                    case State::COMMAND:
+                        _command = byte;
+                        _checksum = byte;
+                        _state = State::LENGTH1;
+                        break;
+                    case State::LENGTH1:
+                        _length = byte;
+                        _checksum += byte;
+                        _state = State::LENGTH2;
+                        break;
+                    case State::LENGTH2:
+                        _length |= byte << 8;
+                        _checksum += byte;
+                        _pos = 0;
+                        _state = _length ? State::PAYLOAD : State::CHECKSUM;
+                        break;
+                    case State::PAYLOAD:
+                        _checksum += byte;
+                        _payload(byte);
+                        if (++_pos == _length) {
+                            _state = State::CHECKSUM;
+                        }
+                        break;
+                    case State::CHECKSUM:
+                        _state = State::MAGIC1;
+                        if (static_cast<uint8_t>(_checksum + byte) != 0xff) {
+                            _errors++;
+                            // a damaged commit is answered with a single error. other packets are reported with
+                            // the next commit
+                            if (_command != kCommit) {
+                                _error = true;
+                                break;
+                            }
+                            _error = false;
+                            return Result::ERROR;
+                        }
+                        if (_command == kCommit) {
+                            if (_error) {
+                                _error = false;
+                                return Result::ERROR;
+                            }
+                            _frames++;
+                            return Result::COMMIT;
+                        }
+                        break;
+                }
+                return Result::NONE;
+            }
+
+            // process data until a commit or error occurs
+            // returns the number of bytes consumed in size
+            Result feed(const uint8_t *data, size_t &size) {
+                for(size_t i = 0; i < size; i++) {
+                    auto result = feed(data[i]);
+                    if (result != Result::NONE) {
+                        size = i + 1;
+                        return result;
+                    }
+                }
+                return Result::NONE;
+            }
+
+            // read all available bytes from a stream and stop after a commit or error
+            template<typename _Stream>
+            Result read(_Stream &stream) {
+                while (stream.available() > 0) {
+                    auto result = feed(static_cast<uint8_t>(stream.read()));
+                    if (result != Result::NONE) {
+                        return result;
+                    }
+                }
+                return Result::NONE;
+            }
+
+            // discard a partially received packet
+            void reset() {
+                _state = State::MAGIC1;
+                _error = false;
+            }
+
+            uint32_t getFrames() const {
+                return _frames;
+            }
+
+            uint32_t getErrors() const {
+                return _errors;
+            }
+
+            pixel_type *palette() {
+                return _palette;
+            }
+
+        private:
+            enum class State : uint8_t {
+                MAGIC1,
+                MAGIC2,
+                COMMAND,
+                LENGTH1,
+                LENGTH2,
+                PAYLOAD,
+                CHECKSUM,
+            };
+
+            __attribute__((always_inline)) inline void _payload(uint8_t byte) {
+                switch(_command) {
+                    case kFill:
+                        if (_pos < 2) {
+                            _readOffset(byte);
+                        }
+                        else if (_pos < 4) {
+                            _count = (_pos == 2) ? byte : (_count | (byte << 8));
+                        }
+                        else if (_pos < 7) {
+                            _rgb[_pos - 4] = byte;
+                            if (_pos == 6 && _offset < _numPixels) {
+                                uint16_t count = std::min<uint16_t>(_count, _numPixels - _offset);
+                                _markDirty(_offset, count);
+                                fillPixels(_pixels + _offset, count, pixel_type(_rgb[0], _rgb[1], _rgb[2]));
+                            }
+                        }
+                        break;
+                    case kPixels:
+                        if (_pos < 2) {
+                            _readOffset(byte);
+                        }
+                        else if (_readColor(byte) && _offset < _numPixels) {
+                            _markDirty(_offset, 1);
+                            _pixels[_offset++] = pixel_type(_rgb[0], _rgb[1], _rgb[2]);
+                        }
+                        break;
+                    case kPalette:
+                        if (_pos == 0) {
+                            _offset = byte;
+                            _byte = 0;
+                        }
+                        else if (_readColor(byte)) {
+                            _palette[_offset++ % kPaletteSize] = pixel_type(_rgb[0], _rgb[1], _rgb[2]);
+                        }
+                        break;
+                    case kIndexed:
+                        if (_pos < 2) {
+                            _readOffset(byte);
+                        }
+                        else if (_offset < _numPixels) {
+                            _markDirty(_offset, 1);
+                            _pixels[_offset++] = _palette[byte % kPaletteSize];
+                        }
+                        break;
+                    default:
+                        // unknown commands are skipped
+                        break;
+                }
+            }
+
+            __attribute__((always_inline)) inline void _readOffset(uint8_t byte) {
+                _offset = (_pos == 0) ? byte : (_offset | (byte << 8));
+                _byte = 0;
+            }
+
+            #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                __attribute__((always_inline)) inline void _markDirty(uint16_t offset, uint16_t numPixels) {
+                    if (_dirty) {
+                        _dirty->markDirty(offset, numPixels);
+                    }
+                }
+            #else
+                __attribute__((always_inline)) inline void _markDirty(uint16_t, uint16_t) {}
+            #endif
+
+            // returns true if a complete color has been received
+            __attribute__((always_inline)) inline bool _readColor(uint8_t byte) {
+                _rgb[_byte++] = byte;
+                if (_byte == 3) {
+                    _byte = 0;
+                    return true;
+                }
+                return false;
+            }
+
+        private:
+            pixel_type *_pixels;
+            uint16_t _numPixels;
+            State _state;
+            uint8_t _command;
+            uint8_t _checksum;
+            uint8_t _byte;
+            bool _error;
+            uint16_t _length;
+            uint16_t _pos;
+            uint16_t _offset;
+            uint16_t _count;
+            uint8_t _rgb[3];
+            uint32_t _frames;
+            uint32_t _errors;
+            pixel_type _palette[kPaletteSize];
+            #if NEOPIXEL_HAVE_DIRTY_TRACKING
+                DirtyTracking *_dirty;
+            #endif
+        };
+
+    }
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
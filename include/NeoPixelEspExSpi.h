@@ -0,0 +1,375 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#if ESP32
+#   include <driver/spi_master.h>
+#   include <esp_heap_caps.h>
+#elif ESP8266
+#   include <SPI.h>
+#endif
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+#if ESP32
+
+// SPI host of the ESP32, VSPI_HOST or HSPI_HOST
+#ifndef NEOPIXEL_SPI_HOST
+#   define NEOPIXEL_SPI_HOST VSPI_HOST
+#endif
+
+#ifndef NEOPIXEL_SPI_DMA_CHANNEL
+#   define NEOPIXEL_SPI_DMA_CHANNEL 1
+#endif
+
+#endif
+
+namespace NeoPixelEx {
+
+    // clocked chipsets with data and clock line
+    //
+    // a frame starts with 32 zero bits followed by 32 bits per pixel, 3 bits set, 5 bits global brightness and
+    // one byte per color in the order blue, green, red (pixel type BGR). each pixel delays the data by half a clock,
+    // the end frame provides the missing clocks for the last pixels. the SK9822 latches the data with another
+    // 32 zero bits after the last pixel
+    //
+    // with kGlobalBrightness, the brightness of the strip is moved into the 5 bit global brightness of each pixel.
+    // the color values are scaled up to use the full 8 bit, which increases the resolution of dark pixels. the APA102
+    // uses a slow PWM for the global brightness, which might be visible on cameras
+    template<uint32_t _Clock, bool _GlobalBrightness, bool _ResetFrame>
+    struct ClockedChipset {
+        static constexpr uint32_t kClock = _Clock;
+        static constexpr bool kGlobalBrightness = _GlobalBrightness;
+        static constexpr uint8_t kResetFrameSize = _ResetFrame ? 4 : 0;
+        // the data is latched by the clock and does not need any delay
+        static constexpr uint16_t kResetDelay = 0;
+        static constexpr uint32_t kMinDisplayPeriod = 0;
+
+        static constexpr uint32_t getMinDisplayPeriod() {
+            return kMinDisplayPeriod;
+        }
+    };
+
+    template<uint32_t _Clock = 10000000UL, bool _GlobalBrightness = true>
+    using APA102 = ClockedChipset<_Clock, _GlobalBrightness, false>;
+
+    template<uint32_t _Clock = 10000000UL, bool _GlobalBrightness = true>
+    using SK9822 = ClockedChipset<_Clock, _GlobalBrightness, true>;
+
+    namespace Clocked {
+
+        static constexpr uint8_t kStartFrameSize = 4;
+        static constexpr uint8_t kPixelHeader = 0xe0;
+        static constexpr uint8_t kMaxGlobalBrightness = 31;
+
+        // one byte per 16 pixels, min. 32 bit
+        constexpr uint16_t endFrameSize(uint16_t numPixels) {
+            return numPixels < 64 ? 4 : (numPixels + 15) / 16;
+        }
+
+        template<typename _Chipset>
+        constexpr uint16_t frameSize(uint16_t numPixels) {
+            return kStartFrameSize + numPixels * 4 + _Chipset::kResetFrameSize + endFrameSize(numPixels);
+        }
+
+        // global brightness and scale of the color values for each brightness level
+        //
+        // the global brightness of a pixel is the smallest level that can display its brightest color at the requested
+        // brightness. the color values are scaled by brightness * 31 / (255 * level), which cannot exceed 255
+        class GlobalBrightness {
+        public:
+            GlobalBrightness() : _brightness(0) {
+                _update(255);
+            }
+
+            __attribute__((always_inline)) inline void set(uint8_t brightness) {
+                if (brightness != _brightness) {
+                    _update(brightness);
+                }
+            }
+
+            uint8_t get() const {
+                return _brightness;
+            }
+
+            // global brightness for the max. color value of a pixel
+            __attribute__((always_inline)) inline uint8_t getLevel(uint8_t maxValue) const {
+                return _level[maxValue];
+            }
+
+            // color scale 0-7936 for the global brightness level, the result is rounded and shifted right by 8 bit
+            __attribute__((always_inline)) inline uint16_t getScale(uint8_t level) const {
+                return _scale[level];
+            }
+
+        private:
+            void _update(uint8_t brightness) {
+                _brightness = brightness;
+                for(uint16_t i = 0; i < 256; i++) {
+                    _level[i] = (i * brightness * kMaxGlobalBrightness + 255UL * 255 - 1) / (255UL * 255);
+                }
+                _scale[0] = 0;
+                for(uint8_t i = 1; i <= kMaxGlobalBrightness; i++) {
+                    _scale[i] = (brightness * kMaxGlobalBrightness * 256UL) / (255UL * i);
+                }
+            }
+
+        private:
+            uint8_t _brightness;
+            uint8_t _level[256];
+            uint16_t _scale[kMaxGlobalBrightness + 1];
+        };
+
+        // encode numPixels from source, missing pixels are black. returns the end of the frame
+        template<typename _Chipset, typename _Source>
+        inline uint8_t *encode(uint8_t *dst, _Source &source, uint16_t numPixels, const GlobalBrightness &brightness) {
+            auto end = dst + kStartFrameSize;
+            std::fill(dst, end, 0);
+            dst = end;
+            end += numPixels * 4;
+            while (dst < end) {
+                uint8_t c0 = source.available() ? source.load() : 0;
+                uint8_t c1 = source.available() ? source.load() : 0;
+                uint8_t c2 = source.available() ? source.load() : 0;
+                if __CONSTEXPR17 (_Chipset::kGlobalBrightness) {
+                    uint8_t level = brightness.getLevel(std::max(c0, std::max(c1, c2)));
+                    uint32_t scale = brightness.getScale(level);
+                    *dst++ = kPixelHeader | level;
+                    *dst++ = (c0 * scale + 128) >> 8;
+                    *dst++ = (c1 * scale + 128) >> 8;
+                    *dst++ = (c2 * scale + 128) >> 8;
+                }
+                else {
+                    *dst++ = kPixelHeader | kMaxGlobalBrightness;
+                    *dst++ = c0;
+                    *dst++ = c1;
+                    *dst++ = c2;
+                }
+            }
+            end = dst + _Chipset::kResetFrameSize + endFrameSize(numPixels);
+            std::fill(dst, end, 0);
+            return end;
+        }
+
+    }
+
+    #if ESP32
+
+        // output backend for the SPI master with DMA, see DefaultOutput
+        //
+        // show() encodes the frame into the second buffer while the previous frame is sent and returns after
+        // queuing the transfer. the pins can be any output pins
+        template<uint16_t _NumBytes, typename _Chipset, uint8_t _DataPin, uint8_t _ClockPin>
+        class SpiDma {
+        public:
+            using chipset_type = _Chipset;
+
+            static constexpr uint16_t kNumPixels = _NumBytes / 3;
+            // DMA transfers multiples of 32 bit, the padding extends the end frame
+            static constexpr uint16_t kBufferSize = (Clocked::frameSize<_Chipset>(kNumPixels) + 3) & ~3;
+            static constexpr bool kBrightness = _Chipset::kGlobalBrightness;
+
+            static_assert(_NumBytes % 3 == 0, "clocked chipsets require 3 byte per pixel");
+
+            static constexpr bool isValidPin(uint8_t pin) {
+                return pin == _DataPin;
+            }
+
+        public:
+            SpiDma() : _device(nullptr), _buffers{}, _next(0), _busy(false) {}
+
+            void begin() {
+                if (_device) {
+                    return;
+                }
+                for(auto &buffer: _buffers) {
+                    buffer = reinterpret_cast<uint8_t *>(heap_caps_malloc(kBufferSize, MALLOC_CAP_DMA));
+                    if (!buffer) {
+                        _free();
+                        return;
+                    }
+                }
+
+                spi_bus_config_t bus = {};
+                bus.mosi_io_num = _DataPin;
+                bus.miso_io_num = -1;
+                bus.sclk_io_num = _ClockPin;
+                bus.quadwp_io_num = -1;
+                bus.quadhd_io_num = -1;
+                bus.max_transfer_sz = kBufferSize;
+                if (spi_bus_initialize(NEOPIXEL_SPI_HOST, &bus, NEOPIXEL_SPI_DMA_CHANNEL) != ESP_OK) {
+                    _free();
+                    return;
+                }
+
+                spi_device_interface_config_t device = {};
+                device.clock_speed_hz = _Chipset::kClock;
+                device.mode = 0;
+                device.spics_io_num = -1;
+                device.queue_size = 1;
+                if (spi_bus_add_device(NEOPIXEL_SPI_HOST, &device, &_device) != ESP_OK) {
+                    _device = nullptr;
+                    spi_bus_free(NEOPIXEL_SPI_HOST);
+                    _free();
+                }
+            }
+
+            void end() {
+                if (!_device) {
+                    return;
+                }
+                wait();
+                spi_bus_remove_device(_device);
+                spi_bus_free(NEOPIXEL_SPI_HOST);
+                _device = nullptr;
+                _free();
+            }
+
+            void setBrightness(uint8_t brightness) {
+                _brightness.set(brightness);
+            }
+
+            template<typename _Source>
+            bool show(_Source &source, Context &context) {
+                if (!_device) {
+                    return false;
+                }
+                auto buffer = _buffers[_next];
+                auto end = Clocked::encode<_Chipset>(buffer, source, kNumPixels, _brightness);
+                std::fill(end, buffer + kBufferSize, 0);
+
+                wait();
+                _transaction = {};
+                _transaction.length = kBufferSize * 8;
+                _transaction.tx_buffer = buffer;
+                bool result = spi_device_queue_trans(_device, &_transaction, portMAX_DELAY) == ESP_OK;
+                if (result) {
+                    _busy = true;
+                    _next ^= 1;
+                }
+
+                #if NEOPIXEL_HAVE_STATS
+                    context.getStats().increment(result);
+                #endif
+                context.setLastDisplayTime(micros());
+                return result;
+            }
+
+            // returns true until the last frame has been sent
+            bool isBusy() {
+                spi_transaction_t *transaction;
+                if (_busy && spi_device_get_trans_result(_device, &transaction, 0) == ESP_OK) {
+                    _busy = false;
+                }
+                return _busy;
+            }
+
+            void wait() {
+                if (_busy) {
+                    spi_transaction_t *transaction;
+                    spi_device_get_trans_result(_device, &transaction, portMAX_DELAY);
+                    _busy = false;
+                }
+            }
+
+        private:
+            void _free() {
+                for(auto &buffer: _buffers) {
+                    if (buffer) {
+                        heap_caps_free(buffer);
+                        buffer = nullptr;
+                    }
+                }
+            }
+
+        private:
+            spi_device_handle_t _device;
+            spi_transaction_t _transaction;
+            uint8_t *_buffers[2];
+            uint8_t _next;
+            bool _busy;
+            Clocked::GlobalBrightness _brightness;
+        };
+
+        // Strip<23, 144, BGR, APA102<>, PixelData<144, BGR>, SpiOutput<23, 18>>
+        template<uint8_t _DataPin = 23, uint8_t _ClockPin = 18>
+        struct SpiOutput {
+            template<uint16_t _NumBytes, typename _Chipset>
+            using type = SpiDma<_NumBytes, _Chipset, _DataPin, _ClockPin>;
+        };
+
+    #elif ESP8266
+
+        // output backend for HSPI, see DefaultOutput
+        //
+        // the data is written to the FIFO of the SPI unit by the CPU and show() returns after the frame has been sent.
+        // the pins cannot be changed, data is GPIO13 and clock GPIO14
+        template<uint16_t _NumBytes, typename _Chipset, uint8_t _DataPin, uint8_t _ClockPin>
+        class Hspi {
+        public:
+            using chipset_type = _Chipset;
+
+            static constexpr uint16_t kNumPixels = _NumBytes / 3;
+            static constexpr uint16_t kBufferSize = Clocked::frameSize<_Chipset>(kNumPixels);
+            static constexpr bool kBrightness = _Chipset::kGlobalBrightness;
+
+            static_assert(_NumBytes % 3 == 0, "clocked chipsets require 3 byte per pixel");
+            static_assert(_DataPin == 13, "the data pin of HSPI is GPIO13");
+            static_assert(_ClockPin == 14, "the clock pin of HSPI is GPIO14");
+
+            static constexpr bool isValidPin(uint8_t pin) {
+                return pin == _DataPin;
+            }
+
+        public:
+            void begin() {
+                SPI.begin();
+            }
+
+            void end() {
+                SPI.end();
+            }
+
+            void setBrightness(uint8_t brightness) {
+                _brightness.set(brightness);
+            }
+
+            template<typename _Source>
+            bool show(_Source &source, Context &context) {
+                auto end = Clocked::encode<_Chipset>(_buffer, source, kNumPixels, _brightness);
+                SPI.beginTransaction(SPISettings(_Chipset::kClock, MSBFIRST, SPI_MODE0));
+                SPI.writeBytes(_buffer, end - _buffer);
+                SPI.endTransaction();
+
+                #if NEOPIXEL_HAVE_STATS
+                    context.getStats().increment(true);
+                #endif
+                context.setLastDisplayTime(micros());
+                return true;
+            }
+
+        private:
+            uint8_t _buffer[kBufferSize];
+            Clocked::GlobalBrightness _brightness;
+        };
+
+        // Strip<13, 144, BGR, APA102<>, PixelData<144, BGR>, SpiOutput<>>
+        template<uint8_t _DataPin = 13, uint8_t _ClockPin = 14>
+        struct SpiOutput {
+            template<uint16_t _NumBytes, typename _Chipset>
+            using type = Hspi<_NumBytes, _Chipset, _DataPin, _ClockPin>;
+        };
+
+    #endif
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
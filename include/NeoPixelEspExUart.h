@@ -0,0 +1,250 @@
+/**
+ * Author: sascha_lammers@gmx.de
+ */
+
+#pragma once
+
+#include "NeoPixelEspEx.h"
+
+#pragma GCC push_options
+#pragma GCC optimize ("O3")
+
+namespace NeoPixelEx {
+
+    // UART output for ESP8266
+    //
+    // the TX output is inverted and each bit is sent as kSamplesPerBit UART bits. the start bit is the high time at the
+    // beginning of the first bit, the stop bit the low time at the end of the last bit. the data bits create the rest
+    // of the waveform
+    //
+    // 6N1 sends 2 bits per UART byte, 0 = 1000, 1 = 1110
+    // 7N1 sends 3 bits per UART byte, 0 = 100, 1 = 110
+    //
+    // the timings T0H and T1H of the chipset are not used
+    namespace Uart {
+
+        template<uint8_t _BitsPerByte, uint8_t _SamplesPerBit>
+        struct Encoding {
+            static constexpr uint8_t kBitsPerByte = _BitsPerByte;
+            static constexpr uint8_t kSamplesPerBit = _SamplesPerBit;
+            static constexpr uint8_t kDataBits = _BitsPerByte * _SamplesPerBit - 2;
+            static constexpr uint8_t kMask = (1 << _BitsPerByte) - 1;
+
+            // UART byte for kBitsPerByte bits, the first bit is the MSB
+            static constexpr uint8_t encode(uint8_t bits) {
+                return _encode(bits, 1);
+            }
+
+            // the data bits are sent LSB first and inverted. a sample is high at the beginning of each bit and in the
+            // middle of a 1 bit
+            static constexpr uint8_t _encode(uint8_t bits, uint8_t sample) {
+                return sample > kDataBits ? 0 :
+                    ((_isHigh(bits, sample) ? 0 : (1 << (sample - 1))) | _encode(bits, sample + 1));
+            }
+
+            static constexpr bool _isHigh(uint8_t bits, uint8_t sample) {
+                return (sample % _SamplesPerBit == 0) ||
+                    (((bits >> (_BitsPerByte - 1 - sample / _SamplesPerBit)) & 1) && (sample % _SamplesPerBit < _SamplesPerBit - 1));
+            }
+        };
+
+        using Encoding6N1 = Encoding<2, 4>;
+        using Encoding7N1 = Encoding<3, 3>;
+
+        template<typename _Encoding>
+        struct EncodingTable {
+            uint8_t value[1 << _Encoding::kBitsPerByte];
+
+            constexpr EncodingTable() : value{} {
+                for(uint8_t i = 0; i <= _Encoding::kMask; i++) {
+                    value[i] = _Encoding::encode(i);
+                }
+            }
+        };
+
+        // converts bytes into UART bytes
+        // if the number of bits is not a multiple of kBitsPerByte, the last UART byte is padded with 0 bits
+        template<typename _Encoding>
+        class Encoder {
+        public:
+            static constexpr EncodingTable<_Encoding> kTable = EncodingTable<_Encoding>();
+
+            Encoder() : _ptr(nullptr), _end(nullptr), _bits(0), _numBits(0) {}
+
+            Encoder(const uint8_t *data, uint16_t numBytes) : _ptr(data), _end(data + numBytes), _bits(0), _numBits(0) {}
+
+            __attribute__((always_inline)) inline bool available() const {
+                return _numBits || _ptr < _end;
+            }
+
+            __attribute__((always_inline)) inline uint8_t next() {
+                if (_numBits < _Encoding::kBitsPerByte && _ptr < _end) {
+                    _bits = (_bits << 8) | *_ptr++;
+                    _numBits += 8;
+                }
+                if (_numBits >= _Encoding::kBitsPerByte) {
+                    _numBits -= _Encoding::kBitsPerByte;
+                    return kTable.value[(_bits >> _numBits) & _Encoding::kMask];
+                }
+                uint8_t value = (_bits << (_Encoding::kBitsPerByte - _numBits)) & _Encoding::kMask;
+                _numBits = 0;
+                return kTable.value[value];
+            }
+
+            // number of UART bytes for numBytes
+            static constexpr uint16_t size(uint16_t numBytes) {
+                return (numBytes * 8U + _Encoding::kBitsPerByte - 1) / _Encoding::kBitsPerByte;
+            }
+
+        private:
+            const uint8_t *_ptr;
+            const uint8_t *_end;
+            uint16_t _bits;
+            uint8_t _numBits;
+        };
+
+        template<typename _Encoding>
+        constexpr EncodingTable<_Encoding> Encoder<_Encoding>::kTable;
+
+    }
+
+    #if ESP8266
+
+        // output backend for UART1 on GPIO2, see DefaultOutput
+        //
+        // show() copies the data with brightness and color order applied and returns after filling the FIFO.
+        // the FIFO empty interrupt encodes and sends the rest of the frame
+        //
+        // the copy requires _NumBytes of RAM. the source cannot be used by the interrupt handler, it is a temporary
+        // object of Strip::show(), it may read from flash or apply brightness and blending with code that is not in
+        // IRAM, and the application may modify the pixels as soon as show() returns. the copy is 1/2 or 1/3 of the
+        // encoded frame and 1/8 of the RAM I2SDma requires
+        //
+        // the ESP8266 has a single interrupt for both UARTs and the handler of Serial is replaced. Serial (UART0)
+        // can still send data but cannot receive any data
+        template<uint16_t _NumBytes, typename _Chipset, typename _Encoding>
+        class Uart1 {
+        public:
+            using chipset_type = _Chipset;
+            using encoder_type = Uart::Encoder<_Encoding>;
+
+            static constexpr uint32_t kBaudRate = 1000000000ULL * _Encoding::kSamplesPerBit / _Chipset::kNanosPeriod;
+            static constexpr uint16_t kClockDivider = (ESP8266_CLOCK + kBaudRate / 2) / kBaudRate;
+            static constexpr uint8_t kFifoSize = 128;
+            // refill the FIFO if less than kFifoThreshold bytes are left
+            static constexpr uint8_t kFifoThreshold = 32;
+
+            static constexpr bool kBrightness = false;
+
+            static constexpr bool isValidPin(uint8_t pin) {
+                return pin == 2;
+            }
+
+        public:
+            Uart1() : _end(0), _sending(false) {}
+
+            void begin() {
+                pinMode(2, SPECIAL);
+                USD(1) = kClockDivider;
+                USC0(1) = ((_Encoding::kDataBits - 5) << UCBN) | (1 << UCSBN) | _BV(UCTXI);
+                USC0(1) |= _BV(UCRXRST) | _BV(UCTXRST);
+                USC0(1) &= ~(_BV(UCRXRST) | _BV(UCTXRST));
+                USC1(1) = kFifoThreshold << UCFET;
+                USIE(1) = 0;
+                USIC(1) = 0xffff;
+                ETS_UART_INTR_ATTACH(_isr, this);
+                ETS_UART_INTR_ENABLE();
+            }
+
+            void end() {
+                wait();
+                USIE(1) = 0;
+                pinMode(2, INPUT);
+            }
+
+            template<typename _Source>
+            bool show(_Source &source, Context &context) {
+                wait();
+                auto ptr = _data;
+                while (source.available()) {
+                    *ptr++ = source.load();
+                }
+                _encoder = encoder_type(_data, ptr - _data);
+                // the frame ends after the last UART byte has left the shift register
+                _end = micros() + (encoder_type::size(ptr - _data) * _Encoding::kBitsPerByte * _Chipset::kNanosPeriod + 999) / 1000;
+                _fill();
+                _sending = _encoder.available();
+                if (_sending) {
+                    // _encoder must be stored before the interrupt handler can read it
+                    std::atomic_signal_fence(std::memory_order_release);
+                    USIC(1) = _BV(UIFE);
+                    USIE(1) |= _BV(UIFE);
+                }
+
+                #if NEOPIXEL_HAVE_STATS
+                    context.getStats().increment(true);
+                #endif
+                context.setLastDisplayTime(micros());
+                return true;
+            }
+
+            // returns true until all bytes have been sent
+            bool isBusy() const {
+                return _sending || ((USS(1) >> USTXC) & 0xff);
+            }
+
+            // wait until the frame and the reset have been sent
+            void wait() {
+                while (isBusy()) {
+                }
+                int32_t remaining = static_cast<int32_t>(_end - micros()) + _Chipset::kResetDelay;
+                if (remaining > 0) {
+                    delayMicroseconds(remaining);
+                }
+            }
+
+        private:
+            __attribute__((always_inline)) inline void _fill() {
+                uint8_t count = kFifoSize - 1 - ((USS(1) >> USTXC) & 0xff);
+                while (count-- && _encoder.available()) {
+                    USF(1) = _encoder.next();
+                }
+            }
+
+            static void IRAM_ATTR _isr(void *arg) {
+                auto &self = *reinterpret_cast<Uart1 *>(arg);
+                if (USIS(1) & _BV(UIFE)) {
+                    self._fill();
+                    if (!self._encoder.available()) {
+                        USIE(1) &= ~_BV(UIFE);
+                        self._sending = false;
+                    }
+                }
+                USIC(1) = 0xffff;
+                // UART0 is not handled
+                USIC(0) = 0xffff;
+            }
+
+        private:
+            uint8_t _data[_NumBytes];
+            // only accessed by the interrupt handler while _sending is true
+            encoder_type _encoder;
+            uint32_t _end;
+            volatile bool _sending;
+        };
+
+        // Strip<2, 300, GRB, TimingsWS2812, PixelData<300, GRB>, Uart1Output<>>
+        template<typename _Encoding = Uart::Encoding7N1>
+        struct Uart1Output {
+            template<uint16_t _NumBytes, typename _Chipset>
+            using type = Uart1<_NumBytes, _Chipset, _Encoding>;
+        };
+
+    #endif
+
+}
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpragmas"
+#pragma GCC pop_options
+#pragma GCC diagnostic pop
@@ -0,0 +1,72 @@
+#
+# Author: sascha_lammers@gmx.de
+#
+# compiles and runs the host tests in test/host with the Arduino shim in test/host/shim
+#
+# python host_tests.py [--cxx g++] [--filter serial] [--verbose]
+#
+# a test can add compiler flags with a line starting with "// flags:" and is only compiled if it contains
+# "// syntax-only", for example for the bit banging code that requires the cycle counter of the ESP8266
+#
+
+import argparse
+import glob
+import os
+import subprocess
+import sys
+import tempfile
+
+ROOT = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+TEST_DIR = os.path.join(ROOT, 'test', 'host')
+CXXFLAGS = ['-std=gnu++17', '-O2', '-Wall', '-Wextra', '-pthread']
+
+def read_options(source):
+    flags = []
+    syntax_only = False
+    with open(source, 'rt') as file:
+        for line in file:
+            line = line.strip()
+            if line.startswith('// flags:'):
+                flags += line[9:].split()
+            elif line == '// syntax-only':
+                syntax_only = True
+    return flags, syntax_only
+
+def run_test(cxx, source, build_dir):
+    name = os.path.splitext(os.path.basename(source))[0]
+    flags, syntax_only = read_options(source)
+    includes = ['-I' + os.path.join(TEST_DIR, 'shim'), '-I' + os.path.join(ROOT, 'include')]
+    if syntax_only:
+        cmd = [cxx] + CXXFLAGS + flags + includes + ['-fsyntax-only', source]
+    else:
+        binary = os.path.join(build_dir, name)
+        cmd = [cxx] + CXXFLAGS + flags + includes + [source, os.path.join(TEST_DIR, 'stubs.cpp'), os.path.join(ROOT, 'src', 'NeoPixelEspEx.cpp'), '-o', binary]
+    result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+    if result.returncode != 0:
+        return False, result.stdout
+    if syntax_only:
+        return True, 'syntax ok'
+    result = subprocess.run([binary], stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True, cwd=TEST_DIR)
+    return result.returncode == 0, result.stdout
+
+parser = argparse.ArgumentParser(description='NeoPixelEx host tests')
+parser.add_argument('--cxx', default='g++', help='C++ compiler')
+parser.add_argument('--filter', default='', help='run tests containing this string only')
+parser.add_argument('--verbose', action='store_true', help='display the output of passed tests')
+args = parser.parse_args()
+
+failed = []
+with tempfile.TemporaryDirectory() as build_dir:
+    for source in sorted(glob.glob(os.path.join(TEST_DIR, 'test_*.cpp'))):
+        if args.filter not in os.path.basename(source):
+            continue
+        success, output = run_test(args.cxx, source, build_dir)
+        print('%s %s' % ('PASS' if success else 'FAIL', os.path.basename(source)))
+        if not success or args.verbose:
+            print(output.rstrip())
+        if not success:
+            failed.append(source)
+
+if failed:
+    print('%u test(s) failed' % len(failed))
+    sys.exit(1)
@@ -0,0 +1,107 @@
+#
+# Author: sascha_lammers@gmx.de
+#
+# creates a C array for NeoPixelEx::RLEPlayer from raw RGB frames (3 byte per pixel, frames stored one after another)
+#
+# python rle_encode.py --pixels 100 --delay 20 frames.rgb > animation.h
+#
+
+import argparse
+import sys
+
+SKIP = 0x00
+RUN = 0x40
+LITERAL = 0x80
+END_OF_FRAME = 0xc0
+MAX_COUNT = 64
+FLAG_NO_DELTA = 0x0001
+
+def encode_frame(pixels, prev):
+    out = bytearray()
+    literal = []
+
+    def flush_literal():
+        while literal:
+            chunk = literal[:MAX_COUNT]
+            del literal[:MAX_COUNT]
+            out.append(LITERAL | (len(chunk) - 1))
+            for color in chunk:
+                out.extend(color)
+
+    n = len(pixels)
+    i = 0
+    while i < n:
+        # unchanged pixels
+        j = i
+        while prev is not None and j < n and pixels[j] == prev[j]:
+            j += 1
+        if j - i >= 2 or (j == n and j > i):
+            flush_literal()
+            count = j - i
+            i = j
+            if i < n:
+                while count:
+                    num = min(count, MAX_COUNT)
+                    out.append(SKIP | (num - 1))
+                    count -= num
+            continue
+        # run of the same color
+        j = i
+        while j < n and pixels[j] == pixels[i]:
+            j += 1
+        if j - i >= 2:
+            flush_literal()
+            count = j - i
+            while count:
+                num = min(count, MAX_COUNT)
+                out.append(RUN | (num - 1))
+                out.extend(pixels[i])
+                count -= num
+            i = j
+            continue
+        literal.append(pixels[i])
+        i += 1
+    flush_literal()
+    out.append(END_OF_FRAME)
+    return out
+
+def main():
+    parser = argparse.ArgumentParser(description='RLE encoder for NeoPixelEx::RLEPlayer')
+    parser.add_argument('file', type=argparse.FileType('rb'), help='raw RGB frames')
+    parser.add_argument('--pixels', type=int, required=True, help='number of pixels per frame')
+    parser.add_argument('--delay', type=int, default=20, help='frame delay in milliseconds')
+    parser.add_argument('--no-delta', action='store_true', help='encode full frames that can be sent without pixel buffer')
+    parser.add_argument('--name', default='animation', help='name of the array')
+    args = parser.parse_args()
+
+    data = args.file.read()
+    frame_size = args.pixels * 3
+    if not data or len(data) % frame_size:
+        print('file size must be a multiple of %u' % frame_size, file=sys.stderr)
+        sys.exit(1)
+
+    frames = []
+    for ofs in range(0, len(data), frame_size):
+        raw = data[ofs:ofs + frame_size]
+        frames.append([bytes(raw[i:i + 3]) for i in range(0, frame_size, 3)])
+
+    flags = FLAG_NO_DELTA if args.no_delta else 0
+    out = bytearray()
+    for value in (args.pixels, len(frames), args.delay, flags):
+        out.extend(value.to_bytes(2, 'little'))
+    prev = None
+    for pixels in frames:
+        out.extend(encode_frame(pixels, prev))
+        if not args.no_delta:
+            prev = pixels
+    while len(out) % 4:
+        out.append(0)
+
+    print('// %u frames, %u pixels, %u byte' % (len(frames), args.pixels, len(out)))
+    print('static const uint8_t %s[] PROGMEM __attribute__((aligned(4))) = {' % args.name)
+    for ofs in range(0, len(out), 16):
+        print('    ' + ', '.join('0x%02x' % b for b in out[ofs:ofs + 16]) + ',')
+    print('};')
+
+if __name__ == '__main__':
+    main()
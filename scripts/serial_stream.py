@@ -0,0 +1,95 @@
+#
+# Author: sascha_lammers@gmx.de
+#
+# sends raw RGB frames (3 byte per pixel, frames stored one after another) to NeoPixelEx::SerialProtocol::Parser
+# only pixels that changed since the previous frame are sent
+#
+# python serial_stream.py --port COM3 --baud 921600 --pixels 1000 --fps 60 frames.rgb
+#
+# requires pyserial
+#
+
+import argparse
+import sys
+import time
+
+MAGIC = b'NX'
+FILL = 0x01
+PIXELS = 0x02
+COMMIT = 0x05
+ACK = b'A'
+# packet overhead in byte, runs with a smaller gap are merged
+MERGE_GAP = 3
+
+def packet(command, payload=b''):
+    header = bytes([command]) + len(payload).to_bytes(2, 'little')
+    checksum = (0xff - sum(header) - sum(payload)) & 0xff
+    return MAGIC + header + payload + bytes([checksum])
+
+def changed_runs(pixels, prev):
+    runs = []
+    for i, color in enumerate(pixels):
+        if prev is not None and prev[i] == color:
+            continue
+        if runs and i - runs[-1][1] <= MERGE_GAP:
+            runs[-1][1] = i + 1
+        else:
+            runs.append([i, i + 1])
+    return runs
+
+def encode_frame(pixels, prev):
+    out = bytearray()
+    for start, end in changed_runs(pixels, prev):
+        run = pixels[start:end]
+        offset = start.to_bytes(2, 'little')
+        if len(run) > 2 and run.count(run[0]) == len(run):
+            out += packet(FILL, offset + len(run).to_bytes(2, 'little') + run[0])
+        else:
+            out += packet(PIXELS, offset + b''.join(run))
+    out += packet(COMMIT)
+    return out
+
+def main():
+    parser = argparse.ArgumentParser(description='serial streaming for NeoPixelEx::SerialProtocol')
+    parser.add_argument('file', type=argparse.FileType('rb'), help='raw RGB frames')
+    parser.add_argument('--port', required=True, help='serial port')
+    parser.add_argument('--baud', type=int, default=921600, help='baud rate')
+    parser.add_argument('--pixels', type=int, required=True, help='number of pixels per frame')
+    parser.add_argument('--fps', type=float, default=0, help='max. frames per second, 0 = unlimited')
+    parser.add_argument('--loop', action='store_true', help='repeat the animation')
+    args = parser.parse_args()
+
+    import serial
+
+    data = args.file.read()
+    frame_size = args.pixels * 3
+    if not data or len(data) % frame_size:
+        print('file size must be a multiple of %u' % frame_size, file=sys.stderr)
+        sys.exit(1)
+    frames = []
+    for ofs in range(0, len(data), frame_size):
+        raw = data[ofs:ofs + frame_size]
+        frames.append([bytes(raw[i:i + 3]) for i in range(0, frame_size, 3)])
+
+    port = serial.Serial(args.port, args.baud, timeout=1)
+    prev = None
+    sent = 0
+    start = time.monotonic()
+    while True:
+        for pixels in frames:
+            frame_start = time.monotonic()
+            port.write(encode_frame(pixels, prev))
+            if port.read(1) == ACK:
+                prev = pixels
+            else:
+                # resend all pixels with the next frame
+                prev = None
+            sent += 1
+            if args.fps:
+                time.sleep(max(0, 1.0 / args.fps - (time.monotonic() - frame_start)))
+        print('frames=%u fps=%.1f' % (sent, sent / (time.monotonic() - start)), file=sys.stderr)
+        if not args.loop:
+            break
+
+if __name__ == '__main__':
+    main()
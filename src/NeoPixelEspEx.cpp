@@ -14,8 +14,21 @@
 
 #include "NeoPixelEspEx.h"
 
+// initialized statically
 NeoPixelEx::Context NeoPixelEx::_globalContext;
 
+#if NEOPIXEL_DEBUG
+#   if (NEOPIXEL_DEBUG_TRIGGER_PIN >= 0)
+        NeoPixelEx::DebugContext NeoPixelEx::_debugContext(NEOPIXEL_DEBUG_TRIGGER_PIN, NEOPIXEL_DEBUG_TRIGGER_PIN2);
+#   else
+        NeoPixelEx::DebugContext NeoPixelEx::_debugContext;
+#   endif
+#endif
+
 #if ESP32
     NeoPixelEx::RTM_Adapter_Data_t NeoPixelEx::rmtChannelsInUse[NeoPixelEx::kMaxRmtChannels] = {};
 #endif
+
+#if NEOPIXEL_MAX_REGISTERED_STRIPS
+    NeoPixelEx::StripRegistry NeoPixelEx::_stripRegistry;
+#endif
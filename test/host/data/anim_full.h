@@ -0,0 +1,128 @@
+// 20 frames, 50 pixels, 1996 byte
+static const uint8_t anim_full[] PROGMEM __attribute__((aligned(4))) = {
+    0x32, 0x00, 0x14, 0x00, 0x14, 0x00, 0x01, 0x00, 0x41, 0x00, 0x00, 0x00, 0x82, 0x96, 0xb4, 0x42,
+    0x30, 0x97, 0xad, 0xbd, 0xef, 0x48, 0x45, 0x30, 0x97, 0xad, 0x84, 0x00, 0xc3, 0x37, 0x30, 0x97,
+    0xad, 0x48, 0xa6, 0xc0, 0x30, 0x97, 0xad, 0xfc, 0x95, 0xf5, 0x46, 0x44, 0x78, 0xbe, 0x8a, 0xe8,
+    0x7a, 0xc7, 0xf5, 0xa5, 0x37, 0x0f, 0xc4, 0x1b, 0xdb, 0x72, 0x3b, 0x44, 0x78, 0xbe, 0xfb, 0x6c,
+    0x47, 0xc0, 0xb5, 0x78, 0x44, 0x78, 0xbe, 0xb2, 0xc5, 0xc1, 0x44, 0x78, 0xbe, 0x97, 0xdd, 0xb9,
+    0x42, 0x44, 0x78, 0xbe, 0x80, 0xca, 0x20, 0x31, 0x43, 0x44, 0x78, 0xbe, 0x82, 0xb2, 0x00, 0xda,
+    0x44, 0x78, 0xbe, 0xdb, 0xa5, 0xee, 0x43, 0x44, 0x78, 0xbe, 0x80, 0xf0, 0x4d, 0x82, 0xc0, 0x41,
+    0x00, 0x00, 0x00, 0x82, 0x96, 0xb4, 0x42, 0x30, 0x97, 0xad, 0xbd, 0xef, 0x48, 0x45, 0x30, 0x97,
+    0xad, 0x85, 0x00, 0xc3, 0x37, 0x30, 0x97, 0xad, 0x48, 0xa6, 0xc0, 0x30, 0x97, 0xad, 0xfc, 0x95,
+    0xf5, 0x44, 0x78, 0xbe, 0x41, 0x92, 0x78, 0x10, 0x80, 0xbc, 0xa1, 0x1e, 0x42, 0x92, 0x78, 0x10,
+    0x80, 0x3c, 0xa6, 0x95, 0x41, 0x92, 0x78, 0x10, 0x80, 0x11, 0x66, 0x0c, 0x42, 0x92, 0x78, 0x10,
+    0x80, 0xba, 0x9f, 0x5e, 0x41, 0x92, 0x78, 0x10, 0x80, 0xef, 0x53, 0x7b, 0x43, 0x92, 0x78, 0x10,
+    0x43, 0x44, 0x78, 0xbe, 0x82, 0xb2, 0x00, 0xda, 0x44, 0x78, 0xbe, 0xdb, 0xa5, 0xee, 0x43, 0x44,
+    0x78, 0xbe, 0x80, 0xf0, 0x4d, 0x82, 0xc0, 0x41, 0x1f, 0xe7, 0xd2, 0x82, 0xb3, 0x30, 0x24, 0x1f,
+    0xe7, 0xd2, 0x2f, 0xf1, 0x1b, 0x42, 0x1f, 0xe7, 0xd2, 0x41, 0xdf, 0x84, 0x08, 0x49, 0xd3, 0x5e,
+    0x73, 0x48, 0x05, 0x35, 0x5e, 0x86, 0xd3, 0x9d, 0x07, 0x05, 0x35, 0x5e, 0x24, 0x13, 0x2d, 0x05,
+    0x35, 0x5e, 0xb3, 0x6a, 0xf7, 0x05, 0x35, 0x5e, 0x7a, 0xaf, 0xd8, 0x44, 0x05, 0x35, 0x5e, 0x80,
+    0xa4, 0xc5, 0xa5, 0x42, 0x05, 0x35, 0x5e, 0x80, 0xbf, 0x7f, 0x33, 0x43, 0x05, 0x35, 0x5e, 0xc0,
+    0x41, 0x1f, 0xe7, 0xd2, 0x82, 0xb3, 0x30, 0x24, 0x1f, 0xe7, 0xd2, 0x2f, 0xf1, 0x1b, 0x42, 0x1f,
+    0xe7, 0xd2, 0x41, 0xdf, 0x84, 0x08, 0x41, 0xd3, 0x5e, 0x73, 0x86, 0xf0, 0x0b, 0x1b, 0x06, 0xf1,
+    0x2b, 0xde, 0x12, 0x6e, 0x06, 0xf1, 0x2b, 0xd3, 0xdd, 0xc1, 0x06, 0xf1, 0x2b, 0x55, 0xad, 0x4b,
+    0x41, 0x06, 0xf1, 0x2b, 0x81, 0x27, 0xbd, 0x6e, 0x06, 0xf1, 0x2b, 0x41, 0x8d, 0xc7, 0xc1, 0x82,
+    0x27, 0xe5, 0x1c, 0xc7, 0x32, 0x99, 0xbf, 0xd1, 0x46, 0x45, 0x8d, 0xc7, 0xc1, 0x80, 0x3b, 0xaf,
+    0x49, 0x41, 0x8d, 0xc7, 0xc1, 0x82, 0xf7, 0x49, 0x3f, 0x8d, 0xc7, 0xc1, 0x81, 0xc6, 0x55, 0x42,
+    0x8d, 0xc7, 0xc1, 0x82, 0xe0, 0x5a, 0x46, 0x8d, 0xc7, 0xc1, 0xb5, 0x3f, 0x04, 0x43, 0x8d, 0xc7,
+    0xc1, 0xc0, 0x41, 0x1f, 0xe7, 0xd2, 0x83, 0xe2, 0x71, 0x38, 0x2f, 0x15, 0x22, 0x9b, 0x23, 0x8b,
+    0xd2, 0x3c, 0xd3, 0x41, 0x1f, 0xe7, 0xd2, 0x41, 0xdf, 0x84, 0x08, 0x41, 0xd3, 0x5e, 0x73, 0x86,
+    0xf0, 0x0b, 0x1b, 0x06, 0xf1, 0x2b, 0xde, 0x12, 0x6e, 0x06, 0xf1, 0x2b, 0xd3, 0xdd, 0xc1, 0x06,
+    0xf1, 0x2b, 0x55, 0xad, 0x4b, 0x41, 0x06, 0xf1, 0x2b, 0x88, 0x27, 0xbd, 0x6e, 0x06, 0xf1, 0x2b,
+    0x8d, 0xc7, 0xc1, 0x69, 0xea, 0x2d, 0x6e, 0x86, 0xa1, 0x94, 0x37, 0xa5, 0x6b, 0x44, 0xc3, 0xf4,
+    0x94, 0x26, 0xee, 0x68, 0x0a, 0x42, 0xf4, 0x94, 0x26, 0x82, 0xae, 0x66, 0x33, 0xf4, 0x94, 0x26,
+    0x58, 0x70, 0xca, 0x42, 0xf4, 0x94, 0x26, 0x81, 0xc7, 0xc8, 0x55, 0x3a, 0xc4, 0x60, 0x45, 0xf4,
+    0x94, 0x26, 0x82, 0x88, 0x2f, 0x77, 0xd5, 0xe3, 0x61, 0xf4, 0x94, 0x26, 0xc0, 0x41, 0x1f, 0xe7,
+    0xd2, 0x42, 0xa9, 0xa0, 0x71, 0x80, 0x37, 0x9f, 0x3d, 0x42, 0xa9, 0xa0, 0x71, 0x84, 0xb3, 0xac,
+    0x82, 0xa9, 0xa0, 0x71, 0x9c, 0x21, 0xc8, 0xa9, 0xa0, 0x71, 0xfb, 0x05, 0x9c, 0x42, 0xa9, 0xa0,
+    0x71, 0x80, 0x6f, 0xc4, 0x31, 0x47, 0xa9, 0xa0, 0x71, 0x80, 0xf9, 0x03, 0x00, 0x42, 0xa9, 0xa0,
+    0x71, 0x41, 0x44, 0x63, 0xe4, 0x80, 0x0a, 0xff, 0x5c, 0x44, 0x44, 0x63, 0xe4, 0x80, 0x28, 0xb4,
+    0x9f, 0x44, 0x44, 0x63, 0xe4, 0x80, 0xe2, 0x83, 0x22, 0x43, 0x44, 0x63, 0xe4, 0x80, 0xf4, 0x1f,
+    0xcb, 0xc0, 0x41, 0x1f, 0xe7, 0xd2, 0x41, 0x35, 0x33, 0xe0, 0x81, 0x71, 0xa2, 0xa6, 0x16, 0xdc,
+    0xd9, 0x41, 0x35, 0x33, 0xe0, 0x80, 0xc8, 0x2c, 0x31, 0x42, 0x35, 0x33, 0xe0, 0x45, 0x70, 0xca,
+    0x39, 0x82, 0x9f, 0xfc, 0xa7, 0x70, 0xca, 0x39, 0x17, 0xeb, 0xa7, 0x49, 0x70, 0xca, 0x39, 0x42,
+    0x12, 0xf1, 0xbe, 0x83, 0x63, 0x3a, 0xfe, 0x12, 0xf1, 0xbe, 0xb2, 0x90, 0x41, 0x12, 0xf1, 0xbe,
+    0x4a, 0xff, 0x09, 0x47, 0x80, 0xa7, 0xb3, 0xf3, 0xc0, 0x41, 0x1f, 0xe7, 0xd2, 0x80, 0x4c, 0x06,
+    0x67, 0x41, 0xc6, 0x70, 0xa4, 0x80, 0xbf, 0x83, 0xfd, 0x44, 0x09, 0x15, 0xad, 0x43, 0x94, 0x40,
+    0xb1, 0x89, 0xfb, 0xff, 0x40, 0x94, 0x40, 0xb1, 0x48, 0x9c, 0x70, 0xd9, 0x5f, 0x10, 0x5d, 0x9a,
+    0xfb, 0x1d, 0x89, 0x89, 0x94, 0x40, 0xb1, 0x18, 0x04, 0x2d, 0x65, 0x60, 0xfb, 0x68, 0x50, 0x76,
+    0x42, 0x94, 0x40, 0xb1, 0x81, 0x2b, 0xfb, 0x7f, 0xc6, 0x98, 0x57, 0x42, 0x2b, 0xfb, 0x7f, 0x80,
+    0xac, 0xd5, 0x7a, 0x43, 0x2b, 0xfb, 0x7f, 0x82, 0x43, 0x6b, 0xcb, 0x2b, 0xfb, 0x7f, 0x99, 0xdb,
+    0x13, 0x41, 0x2b, 0xfb, 0x7f, 0x86, 0xad, 0x4d, 0xd8, 0x2b, 0xfb, 0x7f, 0x08, 0xf0, 0xaf, 0xbc,
+    0xc8, 0x12, 0x2b, 0xfb, 0x7f, 0xe1, 0x29, 0x0c, 0xc5, 0x96, 0x1f, 0xc0, 0x81, 0x1f, 0xe7, 0xd2,
+    0xb5, 0xca, 0x53, 0x42, 0x5a, 0x3e, 0x53, 0x83, 0x01, 0xeb, 0x88, 0x5a, 0x3e, 0x53, 0x3a, 0x0e,
+    0x2a, 0x0d, 0x9c, 0x36, 0x46, 0x3a, 0x0e, 0x2a, 0x80, 0x37, 0x44, 0x91, 0x42, 0x3a, 0x0e, 0x2a,
+    0x81, 0x46, 0xf1, 0x30, 0x5c, 0x8e, 0x83, 0x43, 0x3a, 0x0e, 0x2a, 0x84, 0xc6, 0x23, 0xee, 0x0d,
+    0xc9, 0xd6, 0xaf, 0x7b, 0x60, 0x63, 0x79, 0xc2, 0xdb, 0x5f, 0xea, 0x41, 0xaf, 0x7b, 0x60, 0x81,
+    0x22, 0xdb, 0x1e, 0xcc, 0x29, 0x60, 0x44, 0xaf, 0x7b, 0x60, 0x80, 0xf7, 0x21, 0x46, 0x42, 0xaf,
+    0x7b, 0x60, 0x42, 0xf8, 0xfc, 0xbd, 0x82, 0x61, 0xa4, 0xa2, 0xef, 0xcd, 0x6b, 0xf8, 0xfc, 0xbd,
+    0xc0, 0x81, 0x1f, 0xe7, 0xd2, 0xb5, 0xca, 0x53, 0x42, 0x5a, 0x3e, 0x53, 0x83, 0x01, 0xeb, 0x88,
+    0x5a, 0x3e, 0x53, 0x3a, 0x0e, 0x2a, 0x0d, 0x9c, 0x36, 0x46, 0x3a, 0x0e, 0x2a, 0x80, 0x37, 0x44,
+    0x91, 0x42, 0x3a, 0x0e, 0x2a, 0x81, 0x46, 0xf1, 0x30, 0x5c, 0x8e, 0x83, 0x43, 0x3a, 0x0e, 0x2a,
+    0x85, 0xc6, 0x23, 0xee, 0x0d, 0xc9, 0xd6, 0xaf, 0x7b, 0x60, 0x63, 0x79, 0xc2, 0xdb, 0x5f, 0xea,
+    0xaf, 0x7b, 0x60, 0x44, 0xd0, 0x28, 0x42, 0x88, 0x59, 0x23, 0xae, 0x12, 0x1d, 0xba, 0xd0, 0x28,
+    0x42, 0xbe, 0x44, 0x2a, 0xd0, 0x28, 0x42, 0x9a, 0xe4, 0x73, 0x1b, 0x0f, 0xec, 0xd0, 0x28, 0x42,
+    0xfb, 0x43, 0x14, 0x41, 0xd0, 0x28, 0x42, 0x81, 0x23, 0x57, 0x99, 0x91, 0x6a, 0xfd, 0xc0, 0x81,
+    0x1f, 0xe7, 0xd2, 0xb5, 0xca, 0x53, 0x42, 0x5a, 0x3e, 0x53, 0x83, 0x01, 0xeb, 0x88, 0x5a, 0x3e,
+    0x53, 0x3a, 0x0e, 0x2a, 0x0d, 0x9c, 0x36, 0x41, 0x3a, 0x0e, 0x2a, 0x83, 0xc5, 0xef, 0xad, 0x65,
+    0x55, 0x14, 0xdc, 0x85, 0x4f, 0x61, 0x94, 0x23, 0x43, 0xdc, 0x85, 0x4f, 0x46, 0x90, 0x35, 0xd3,
+    0x85, 0xd1, 0x1a, 0x95, 0xdc, 0x85, 0x4f, 0x5a, 0x70, 0x8e, 0xdc, 0x85, 0x4f, 0xb6, 0xf0, 0xa1,
+    0x68, 0xd7, 0x7d, 0x43, 0xdc, 0x85, 0x4f, 0x80, 0x6d, 0x06, 0x86, 0x41, 0x93, 0x82, 0x0b, 0x83,
+    0xe9, 0xb7, 0x7f, 0x93, 0x82, 0x0b, 0xac, 0xa1, 0x5c, 0xae, 0x29, 0xfd, 0x42, 0x93, 0x82, 0x0b,
+    0x83, 0x58, 0xf2, 0x96, 0x93, 0x82, 0x0b, 0xe2, 0xc6, 0xcc, 0x93, 0x82, 0x0b, 0xc0, 0x81, 0x1f,
+    0xe7, 0xd2, 0xb5, 0xca, 0x53, 0x42, 0x5a, 0x3e, 0x53, 0x83, 0x01, 0xeb, 0x88, 0x5a, 0x3e, 0x53,
+    0x3a, 0x0e, 0x2a, 0x0d, 0x9c, 0x36, 0x41, 0x3a, 0x0e, 0x2a, 0x83, 0xc5, 0xef, 0xad, 0x65, 0x55,
+    0x14, 0xdc, 0x85, 0x4f, 0x61, 0x94, 0x23, 0x43, 0xdc, 0x85, 0x4f, 0x46, 0x90, 0x35, 0xd3, 0x85,
+    0xd1, 0x1a, 0x95, 0xdc, 0x85, 0x4f, 0x5a, 0x70, 0x8e, 0xdc, 0x85, 0x4f, 0xb6, 0xf0, 0xa1, 0x68,
+    0xd7, 0x7d, 0x42, 0xdc, 0x85, 0x4f, 0x81, 0x75, 0x7b, 0xee, 0x9f, 0x07, 0x18, 0x43, 0x75, 0x7b,
+    0xee, 0x85, 0x93, 0x2f, 0xee, 0x75, 0x7b, 0xee, 0x27, 0x20, 0x28, 0x75, 0x7b, 0xee, 0x93, 0x0e,
+    0x2c, 0x2d, 0x9b, 0x8b, 0x42, 0xb1, 0xc9, 0xac, 0xc0, 0x42, 0x9e, 0xa5, 0xb2, 0x82, 0x69, 0xd1,
+    0xa1, 0x0a, 0xca, 0x3f, 0x2a, 0xd6, 0x05, 0x42, 0x9e, 0xa5, 0xb2, 0x81, 0x5a, 0xfd, 0x05, 0x19,
+    0x28, 0x8e, 0x42, 0x9e, 0xa5, 0xb2, 0x85, 0xca, 0x2e, 0x84, 0x11, 0x2c, 0xf9, 0xcb, 0x31, 0xe4,
+    0x0c, 0xd3, 0x48, 0x6c, 0xc4, 0xa8, 0x5d, 0x00, 0x3d, 0x41, 0x6c, 0xc4, 0xa8, 0x81, 0xc2, 0x8d,
+    0x4c, 0xca, 0xb9, 0x81, 0x49, 0x6c, 0xc4, 0xa8, 0x85, 0xd9, 0x0c, 0xb7, 0x6c, 0xc4, 0xa8, 0xaa,
+    0x70, 0xa9, 0x6c, 0xc4, 0xa8, 0x3d, 0x79, 0xad, 0x77, 0x6d, 0x41, 0x42, 0x6c, 0xc4, 0xa8, 0x82,
+    0xf8, 0x31, 0xf4, 0x6c, 0xc4, 0xa8, 0xc9, 0xc2, 0x5b, 0x43, 0x6c, 0xc4, 0xa8, 0xc0, 0x42, 0x9e,
+    0xa5, 0xb2, 0x81, 0x69, 0xd1, 0xa1, 0xa0, 0x56, 0xa2, 0x46, 0x8b, 0x1b, 0x40, 0x85, 0x04, 0x1c,
+    0xe0, 0x4d, 0x7c, 0x03, 0xe0, 0xe0, 0xd1, 0x4d, 0x7c, 0x03, 0x11, 0x41, 0x56, 0x6b, 0x15, 0x77,
+    0x46, 0x4d, 0x7c, 0x03, 0x80, 0x8e, 0x2a, 0x38, 0x44, 0x4d, 0x7c, 0x03, 0x80, 0xe7, 0x09, 0xe4,
+    0x41, 0x4d, 0x7c, 0x03, 0x80, 0x47, 0x3f, 0x8a, 0x41, 0x4d, 0x7c, 0x03, 0x81, 0xef, 0xb7, 0x2e,
+    0x8d, 0x74, 0x7f, 0x41, 0x4d, 0x7c, 0x03, 0x81, 0xa7, 0x07, 0x2a, 0x58, 0x2c, 0xd6, 0x46, 0x4d,
+    0x7c, 0x03, 0xc0, 0x42, 0x9e, 0xa5, 0xb2, 0x81, 0x69, 0xd1, 0xa1, 0xa0, 0x56, 0xa2, 0x46, 0x8b,
+    0x1b, 0x40, 0x85, 0x04, 0x1c, 0xe0, 0x4d, 0x7c, 0x03, 0xe0, 0xe0, 0xd1, 0x4d, 0x7c, 0x03, 0x11,
+    0x41, 0x56, 0x6b, 0x15, 0x77, 0x46, 0x4d, 0x7c, 0x03, 0x80, 0x8e, 0x2a, 0x38, 0x44, 0x4d, 0x7c,
+    0x03, 0x80, 0xe7, 0x09, 0xe4, 0x41, 0x4d, 0x7c, 0x03, 0x80, 0x47, 0x3f, 0x8a, 0x41, 0x4d, 0x7c,
+    0x03, 0x81, 0xef, 0xb7, 0x2e, 0x8d, 0x74, 0x7f, 0x41, 0x4d, 0x7c, 0x03, 0x81, 0xa7, 0x07, 0x2a,
+    0x58, 0x2c, 0xd6, 0x46, 0x4d, 0x7c, 0x03, 0xc0, 0x42, 0x9e, 0xa5, 0xb2, 0x81, 0x69, 0xd1, 0xa1,
+    0xa0, 0x56, 0xa2, 0x44, 0x8b, 0x1b, 0x40, 0x46, 0x53, 0xa6, 0xcc, 0x82, 0xfb, 0xe1, 0xed, 0x53,
+    0xa6, 0xcc, 0x32, 0x4a, 0xa2, 0x41, 0x53, 0xa6, 0xcc, 0x82, 0xaa, 0xa0, 0x68, 0x53, 0xa6, 0xcc,
+    0x9d, 0xf4, 0xe0, 0x43, 0x53, 0xa6, 0xcc, 0x81, 0x55, 0xa6, 0xa3, 0x1b, 0x0f, 0x56, 0x41, 0x53,
+    0xa6, 0xcc, 0x80, 0xff, 0xa7, 0xda, 0x44, 0x53, 0xa6, 0xcc, 0x81, 0xd0, 0x4f, 0xe6, 0x88, 0x5d,
+    0x7a, 0x41, 0x53, 0xa6, 0xcc, 0x83, 0x61, 0x4e, 0x74, 0x53, 0xa6, 0xcc, 0xda, 0x94, 0x02, 0xa4,
+    0xfb, 0xb4, 0x42, 0x53, 0xa6, 0xcc, 0xc0, 0x8a, 0xe3, 0x9f, 0x73, 0xbf, 0xfe, 0x70, 0xab, 0xa8,
+    0xa5, 0xe3, 0x9f, 0x73, 0xfe, 0xc0, 0x54, 0xe3, 0x9f, 0x73, 0x60, 0xd9, 0x38, 0xe3, 0x9f, 0x73,
+    0x20, 0xd6, 0xfc, 0xc6, 0xd9, 0xfb, 0x23, 0x61, 0x6b, 0x42, 0xe3, 0x9f, 0x73, 0x85, 0x86, 0x76,
+    0x03, 0xe3, 0x9f, 0x73, 0x53, 0xa6, 0xcc, 0xfb, 0xe1, 0xed, 0x53, 0xa6, 0xcc, 0x94, 0xdc, 0x3c,
+    0x43, 0xe5, 0xfa, 0xc1, 0x80, 0xd1, 0x13, 0xae, 0x43, 0xe5, 0xfa, 0xc1, 0x80, 0xd7, 0x38, 0x06,
+    0x41, 0xe5, 0xfa, 0xc1, 0x80, 0x59, 0xd5, 0x81, 0x46, 0x03, 0xf5, 0xd1, 0x82, 0x9a, 0x80, 0x16,
+    0x03, 0xf5, 0xd1, 0x41, 0x2d, 0xc6, 0x46, 0x03, 0xf5, 0xd1, 0xc0, 0x8a, 0xe3, 0x9f, 0x73, 0xbf,
+    0xfe, 0x70, 0xab, 0xa8, 0xa5, 0xe3, 0x9f, 0x73, 0xfe, 0xc0, 0x54, 0xe3, 0x9f, 0x73, 0x60, 0xd9,
+    0x38, 0xe3, 0x9f, 0x73, 0x20, 0xd6, 0xfc, 0xc6, 0xd9, 0xfb, 0x23, 0x61, 0x6b, 0x41, 0xe3, 0x9f,
+    0x73, 0x45, 0x2a, 0x5e, 0xa0, 0x82, 0x9e, 0x2f, 0x61, 0x2a, 0x5e, 0xa0, 0xa2, 0x83, 0x5f, 0x43,
+    0x69, 0x6f, 0xc2, 0x80, 0x21, 0xc8, 0x34, 0x43, 0x69, 0x6f, 0xc2, 0x45, 0xfb, 0x4a, 0x48, 0x80,
+    0x03, 0xbf, 0x3f, 0x43, 0xfb, 0x4a, 0x48, 0x80, 0x95, 0xea, 0xe0, 0x43, 0xfb, 0x4a, 0x48, 0x80,
+    0x41, 0xb8, 0xdd, 0x41, 0xfb, 0x4a, 0x48, 0xc0, 0x8a, 0xe3, 0x9f, 0x73, 0xbf, 0xfe, 0x70, 0xab,
+    0xa8, 0xa5, 0xe3, 0x9f, 0x73, 0xfe, 0xc0, 0x54, 0xe3, 0x9f, 0x73, 0x60, 0xd9, 0x38, 0xe3, 0x9f,
+    0x73, 0x20, 0xd6, 0xfc, 0xc6, 0xd9, 0xfb, 0x23, 0x61, 0x6b, 0x41, 0xe3, 0x9f, 0x73, 0x45, 0x2a,
+    0x5e, 0xa0, 0x82, 0x9e, 0x2f, 0x61, 0x2a, 0x5e, 0xa0, 0xa2, 0x83, 0x5f, 0x43, 0x69, 0x6f, 0xc2,
+    0x80, 0x21, 0xc8, 0x34, 0x43, 0x69, 0x6f, 0xc2, 0x45, 0xfb, 0x4a, 0x48, 0x41, 0x58, 0x3a, 0x85,
+    0x82, 0x2b, 0x89, 0xc1, 0x58, 0x3a, 0x85, 0x1f, 0xc2, 0x15, 0x41, 0x58, 0x3a, 0x85, 0x82, 0xc4,
+    0x37, 0x9f, 0x00, 0x63, 0x45, 0x66, 0x84, 0x4e, 0x42, 0x58, 0x3a, 0x85, 0xc0, 0x81, 0x30, 0x60,
+    0x9e, 0x06, 0xfb, 0xd5, 0x43, 0x30, 0x60, 0x9e, 0x81, 0x7f, 0x45, 0x6b, 0xaf, 0xd6, 0x47, 0x41,
+    0x30, 0x60, 0x9e, 0x84, 0x2c, 0x1c, 0xb8, 0x30, 0x60, 0x9e, 0xe3, 0xb6, 0xd5, 0xf6, 0x6c, 0x93,
+    0x18, 0x57, 0x64, 0x45, 0x67, 0xc6, 0x53, 0x86, 0xce, 0xb3, 0xfc, 0x67, 0xc6, 0x53, 0x1d, 0x09,
+    0xb2, 0x67, 0xc6, 0x53, 0x4d, 0xd9, 0x9a, 0x80, 0x3d, 0x14, 0x72, 0x77, 0x75, 0x45, 0x67, 0xc6,
+    0x53, 0x82, 0xb0, 0xd6, 0xb7, 0x67, 0xc6, 0x53, 0x1b, 0x37, 0x23, 0x41, 0x67, 0xc6, 0x53, 0x80,
+    0xb9, 0xcb, 0x47, 0x42, 0x67, 0xc6, 0x53, 0x84, 0xc5, 0x1d, 0x77, 0x67, 0xc6, 0x53, 0xc5, 0x5d,
+    0x41, 0x67, 0xc6, 0x53, 0xcd, 0xbe, 0x96, 0x41, 0x67, 0xc6, 0x53, 0xc0,
+};
@@ -0,0 +1,118 @@
+// minimal Arduino API for the host tests
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <string>
+#include <algorithm>
+#include <utility>
+
+#ifndef ESP8266
+#   define ESP8266 1
+#endif
+#ifndef F_CPU
+#   define F_CPU 80000000UL
+#endif
+#define ESP8266_CLOCK 80000000UL
+
+#define PSTR(s) (s)
+#define PGM_P const char *
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define PRECACHE_ATTR
+#define PRECACHE_START(x)
+#define PRECACHE_END(x)
+#define memcmp_P memcmp
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define snprintf_P snprintf
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define FUNCTION_1 8
+#define SPECIAL 0xf8
+
+#define _BV(b) (1UL << (b))
+#define microsecondsToClockCycles(a) ((a) * (F_CPU / 1000000L))
+
+inline uint8_t pgm_read_byte(const void *p) { return *reinterpret_cast<const uint8_t *>(p); }
+inline uint16_t pgm_read_word(const void *p) { return *reinterpret_cast<const uint16_t *>(p); }
+// counts 32 bit reads and fails for unaligned addresses, which are split into several reads on the ESP8266
+extern uint32_t pgmReadDwordCount;
+inline uint32_t pgm_read_dword(const void *p) {
+    if (reinterpret_cast<uintptr_t>(p) & 3) {
+        abort();
+    }
+    pgmReadDwordCount++;
+    return *reinterpret_cast<const uint32_t *>(p);
+}
+
+// GPIO registers
+extern volatile uint32_t GPOS, GPOC, GP16O;
+
+// UART registers
+extern volatile uint32_t uartRegs[2][16];
+#define USF(u) uartRegs[u][0]
+#define USD(u) uartRegs[u][1]
+#define USC0(u) uartRegs[u][2]
+#define USC1(u) uartRegs[u][3]
+#define USIE(u) uartRegs[u][4]
+#define USIC(u) uartRegs[u][5]
+#define USIS(u) uartRegs[u][6]
+#define USS(u) uartRegs[u][7]
+#define UCBN 2
+#define UCSBN 4
+#define UCTXI 22
+#define UCRXRST 17
+#define UCTXRST 18
+#define UCFET 8
+#define UIFE 1
+#define USTXC 16
+#define ETS_UART_INTR_ATTACH(f, a)
+#define ETS_UART_INTR_ENABLE()
+
+class String : public std::string {
+public:
+    using std::string::string;
+    String(const std::string &s) : std::string(s) {}
+};
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size) {
+        size_t result = 0;
+        while (size--) {
+            result += write(*buffer++);
+        }
+        return result;
+    }
+    size_t print(const char *str) {
+        return write(reinterpret_cast<const uint8_t *>(str), strlen(str));
+    }
+};
+
+class Stream : public Print {
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+};
+
+// the time is the real time since the start of the test unless setVirtualTime() has been called
+uint32_t micros();
+uint32_t millis();
+uint64_t micros64();
+void setVirtualTime(uint64_t micros);
+void clearVirtualTime();
+void delayMicroseconds(uint32_t);
+void delay(uint32_t);
+void digitalWrite(uint8_t, uint8_t);
+void pinMode(uint8_t, uint8_t);
+void ets_intr_lock();
+void ets_intr_unlock();
+inline void yield() {}
@@ -0,0 +1,2 @@
+// empty for the host tests
+#pragma once
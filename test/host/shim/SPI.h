@@ -0,0 +1,27 @@
+// SPI library that records the data of the last transfer
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+struct SPISettings {
+    SPISettings(uint32_t clock, uint8_t, uint8_t) : clock(clock) {}
+    uint32_t clock;
+};
+
+struct SPIClass {
+    std::vector<uint8_t> data;
+    uint32_t clock = 0;
+    int transactions = 0;
+    bool active = false;
+
+    void begin() { active = true; }
+    void end() { active = false; }
+    void beginTransaction(SPISettings settings) { clock = settings.clock; transactions++; }
+    void endTransaction() {}
+    void writeBytes(const uint8_t *ptr, uint32_t size) { data.assign(ptr, ptr + size); }
+};
+
+extern SPIClass SPI;
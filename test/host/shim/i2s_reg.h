@@ -0,0 +1,43 @@
+// I2S and SLC registers for the host tests
+#pragma once
+extern volatile uint32_t I2SC, I2SFC, I2SCC, I2SIC, I2SIE, SLCC0, SLCIC, SLCIE, SLCIR, SLCRXDC, SLCTXL, SLCRXL;
+#define I2S_CLK_ENABLE()
+#define FUNCTION_1 8
+#define I2SRST 1
+#define I2SDE 1
+#define I2STXFMM 7
+#define I2STXFM 0
+#define I2SRXFMM 7
+#define I2SRXFM 0
+#define I2STXCMM 7
+#define I2STXCM 0
+#define I2SRXCMM 7
+#define I2SRXCM 0
+#define I2STSM 1
+#define I2SRSM 1
+#define I2SBMM 1
+#define I2SBM 1
+#define I2SBDM 63
+#define I2SBD 22
+#define I2SCDM 63
+#define I2SCD 16
+#define I2SRF 1
+#define I2SMR 1
+#define I2SRMS 1
+#define I2STXS 1
+#define SLCRXLR 1
+#define SLCTXLR 1
+#define SLCMM 3
+#define SLCM 12
+#define SLCBINR 1
+#define SLCBTNR 1
+#define SLCBRXFE 1
+#define SLCBRXEM 1
+#define SLCBRXFM 1
+#define SLCTXLAM 0xfffff
+#define SLCTXLA 0
+#define SLCRXLAM 0xfffff
+#define SLCRXLA 0
+#define SLCRXLE (1 << 28)
+#define SLCRXLS (1 << 29)
+#define SLCIRXEOF (1 << 17)
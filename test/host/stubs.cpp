@@ -0,0 +1,60 @@
+#include <Arduino.h>
+#include <SPI.h>
+#include <i2s_reg.h>
+#include <chrono>
+
+volatile uint32_t GPOS, GPOC, GP16O;
+uint32_t pgmReadDwordCount;
+volatile uint32_t uartRegs[2][16];
+volatile uint32_t I2SC, I2SFC, I2SCC, I2SIC, I2SIE, SLCC0, SLCIC, SLCIE, SLCIR, SLCRXDC, SLCTXL, SLCRXL;
+SPIClass SPI;
+
+static auto startTime = std::chrono::steady_clock::now();
+static bool virtualTime = false;
+static uint64_t virtualMicros = 0;
+
+uint64_t micros64()
+{
+    if (virtualTime) {
+        return virtualMicros;
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+uint32_t micros()
+{
+    return micros64();
+}
+
+uint32_t millis()
+{
+    return micros64() / 1000;
+}
+
+void setVirtualTime(uint64_t micros)
+{
+    virtualTime = true;
+    virtualMicros = micros;
+}
+
+void clearVirtualTime()
+{
+    virtualTime = false;
+}
+
+void delayMicroseconds(uint32_t micros)
+{
+    if (virtualTime) {
+        virtualMicros += micros;
+    }
+}
+
+void delay(uint32_t millis)
+{
+    delayMicroseconds(millis * 1000);
+}
+
+void digitalWrite(uint8_t, uint8_t) {}
+void pinMode(uint8_t, uint8_t) {}
+void ets_intr_lock() {}
+void ets_intr_unlock() {}
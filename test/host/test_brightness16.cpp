@@ -0,0 +1,157 @@
+// 16 bit brightness and brightness masks against the exact values, show() after show16() with dirty tracking, and
+// the cost of the 16 bit path per byte
+// flags: -DNEOPIXEL_HAVE_DIRTY_TRACKING=1
+#include "NeoPixelEspEx.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+static constexpr uint16_t kNumPixels = 300;
+
+static uint8_t pixels[kNumPixels * 3];
+
+// stores the bytes of the last frame and counts the frames
+struct RecordingOutput {
+    template<uint16_t _NumBytes, typename _Chipset>
+    using type = RecordingOutput;
+
+    static constexpr bool kBrightness = false;
+
+    static constexpr bool isValidPin(uint8_t) {
+        return true;
+    }
+
+    void begin() {}
+    void end() {}
+    void setBrightness(uint8_t) {}
+
+    template<typename _Source>
+    bool show(_Source &source, Context &context) {
+        frames++;
+        frame.clear();
+        while (source.available()) {
+            frame.push_back(source.load());
+        }
+        context.setLastDisplayTime(micros());
+        return true;
+    }
+
+    static std::vector<uint8_t> frame;
+    static int frames;
+};
+
+std::vector<uint8_t> RecordingOutput::frame;
+int RecordingOutput::frames;
+
+// the bytes of the source, returns the sum
+template<typename _Source>
+static uint32_t drain(_Source source, uint8_t *out = nullptr)
+{
+    uint32_t sum = 0;
+    while (source.available()) {
+        uint8_t value = source.load();
+        if (out) {
+            *out++ = value;
+        }
+        sum += value;
+    }
+    return sum;
+}
+
+// ns per byte
+template<typename _Func>
+static double benchmark(_Func func)
+{
+    static constexpr int kLoops = 20000;
+    volatile uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < kLoops; i++) {
+        sink = sink + func();
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kLoops / sizeof(pixels);
+}
+
+int main()
+{
+    for(size_t i = 0; i < sizeof(pixels); i++) {
+        pixels[i] = (i * 37 + 11) & 0xff;
+    }
+    uint8_t a[sizeof(pixels)];
+    uint8_t b[sizeof(pixels)];
+
+    // full brightness is exact and the same as the 8 bit path
+    drain(PixelSource<GRB>(pixels, sizeof(pixels), 256), a);
+    drain(MaskedPixelSource<GRB, UniformBrightness>(pixels, sizeof(pixels), UniformBrightness(), 0xffff), b);
+    assert(memcmp(a, b, sizeof(a)) == 0);
+
+    // the 16 bit brightness is rounded to the nearest value
+    double maxError = 0;
+    for(uint32_t brightness = 0; brightness < 65536; brightness += 97) {
+        drain(MaskedPixelSource<RGB, UniformBrightness>(pixels, 64, UniformBrightness(), brightness), b);
+        for(int i = 0; i < 64; i++) {
+            maxError = std::max(maxError, std::fabs(b[i] - pixels[i] * (brightness / 65535.0)));
+        }
+    }
+    printf("16 bit brightness max. error %.3f\n", maxError);
+    assert(maxError <= 0.51);
+
+    // 4 bit brightness for each pixel
+    PixelBrightnessMask<kNumPixels> pixelMask;
+    pixelMask.set(1, 0);
+    pixelMask.set(2, 7);
+    pixelMask.fill(10, 5, 3);
+    assert(pixelMask.get(0) == 15 && pixelMask.get(1) == 0 && pixelMask.get(2) == 7 && pixelMask.get(12) == 3 && pixelMask.get(15) == 15);
+    drain(MaskedPixelSource<RGB, PixelBrightnessMask<kNumPixels>>(pixels, sizeof(pixels), pixelMask, 0xffff), b);
+    assert(b[0] == pixels[0] && b[3] == 0 && b[5] == 0);
+    assert(b[6] == static_cast<uint8_t>(std::lround(pixels[6] * 7 / 15.0)) && b[3 * 12 + 1] == static_cast<uint8_t>(std::lround(pixels[37] * 3 / 15.0)));
+
+    // brightness for ranges of pixels, the segment at offset 100 is updated
+    SegmentBrightnessMask<4> segmentMask;
+    assert(segmentMask.set(100, 50, 0) && segmentMask.set(0, 10, 128) && segmentMask.set(200, 100, 255) && segmentMask.set(100, 20, 64));
+    assert(segmentMask.size() == 3);
+    drain(MaskedPixelSource<RGB, SegmentBrightnessMask<4>>(pixels, sizeof(pixels), segmentMask, 0xffff), b);
+    for(int pixel = 0; pixel < kNumPixels; pixel++) {
+        for(int i = pixel * 3; i < pixel * 3 + 3; i++) {
+            uint8_t expected = pixel < 10 ? (pixels[i] * 129 + 128) >> 8 : (pixel >= 100 && pixel < 120) ? (pixels[i] * 64 + 128) >> 8 : pixels[i];
+            assert(b[i] == expected);
+        }
+    }
+
+    // show16() and showMasked() replace the frame on the LEDs and the next show() is not skipped
+    Strip<12, kNumPixels, RGB, TimingsWS2812, PixelData<kNumPixels, RGB>, RecordingOutput> strip;
+    memcpy(strip.data().data(), pixels, sizeof(pixels));
+    strip.data().markDirty();
+    strip.setKeepAliveInterval(0);
+    std::vector<uint8_t> full(pixels, pixels + sizeof(pixels));
+    strip.show(255);
+    assert(RecordingOutput::frames == 1 && RecordingOutput::frame == full);
+    strip.show16(0);
+    assert(RecordingOutput::frames == 2 && std::count(RecordingOutput::frame.begin(), RecordingOutput::frame.end(), 0) == sizeof(pixels));
+    strip.show(255);
+    assert(RecordingOutput::frames == 3 && RecordingOutput::frame == full);
+    strip.show(255);
+    assert(RecordingOutput::frames == 3);
+    strip.showMasked(pixelMask);
+    strip.show(255);
+    assert(RecordingOutput::frames == 5 && RecordingOutput::frame == full);
+
+    // GRB with reordering
+    double time8 = benchmark([] {
+        return drain(PixelSource<GRB>(pixels, sizeof(pixels), 129));
+    });
+    double time16 = benchmark([] {
+        return drain(MaskedPixelSource<GRB, UniformBrightness>(pixels, sizeof(pixels), UniformBrightness(), 0x8000));
+    });
+    double timePixelMask = benchmark([&] {
+        return drain(MaskedPixelSource<GRB, PixelBrightnessMask<kNumPixels>>(pixels, sizeof(pixels), pixelMask, 0x8000));
+    });
+    double timeSegmentMask = benchmark([&] {
+        return drain(MaskedPixelSource<GRB, SegmentBrightnessMask<4>>(pixels, sizeof(pixels), segmentMask, 0x8000));
+    });
+    printf("ns/byte: 8 bit %.2f, 16 bit %.2f, pixel mask %.2f, segment mask %.2f\n", time8, time16, timePixelMask, timeSegmentMask);
+    return 0;
+}
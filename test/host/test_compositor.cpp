@@ -0,0 +1,103 @@
+// compositePixels() against compositeByte() for all modes and opacities, and compose() against CompositorSource
+#include "NeoPixelEspExCompositor.h"
+#include <cassert>
+
+using namespace NeoPixelEx;
+
+static constexpr uint16_t kNumPixels = 37;
+static constexpr BlendMode kModes[] = { BlendMode::NORMAL, BlendMode::ADD, BlendMode::MULTIPLY, BlendMode::MAX };
+
+struct Gradient {
+    GRB operator()(uint16_t index) const {
+        return GRB(index * 13, 255 - index * 5, (index * 91) & 0xff);
+    }
+};
+
+template<typename _Source>
+static void drain(_Source source, uint8_t *out)
+{
+    while (source.available()) {
+        *out++ = source.load();
+    }
+}
+
+int main()
+{
+    // the kernels process 4 bytes at a time, the buffers start at every offset inside a word
+    uint8_t a[kNumPixels * 3 + 4];
+    uint8_t b[kNumPixels * 3 + 4];
+    uint8_t result[kNumPixels * 3 + 4];
+    for(size_t i = 0; i < sizeof(a); i++) {
+        a[i] = (i * 37 + 11) & 0xff;
+        b[i] = (i * 101 + 200) & 0xff;
+    }
+    // include the extremes
+    a[0] = b[1] = 0;
+    a[1] = b[0] = 255;
+    for(auto mode: kModes) {
+        for(int opacity = 0; opacity < 256; opacity++) {
+            uint16_t scale = blendAmount(opacity);
+            for(int dstOffset = 0; dstOffset < 4; dstOffset++) {
+                int srcOffset = 3 - dstOffset;
+                auto dst = result + dstOffset;
+                auto src = b + srcOffset;
+                memcpy(dst, a, kNumPixels * 3);
+                compositePixels(reinterpret_cast<GRB *>(dst), reinterpret_cast<const GRB *>(src), kNumPixels, mode, opacity);
+                for(int i = 0; i < kNumPixels * 3; i++) {
+                    assert(dst[i] == compositeByte(a[i], src[i], mode, scale));
+                }
+            }
+        }
+    }
+
+    // the same layers composed into a buffer and combined while sending
+    Compositor<kNumPixels, GRB> compositor;
+    PixelData<kNumPixels, GRB> base;
+    PixelData<10, GRB> overlay;
+    PixelData<kNumPixels, GRB> shade;
+    GeneratorPixelData<20, Gradient, GRB> gradient;
+    PixelData<5, GRB> disabled;
+    for(uint16_t i = 0; i < kNumPixels; i++) {
+        base[i] = GRB(i * 7, i * 3, 200 - i);
+        shade[i] = GRB(255 - i * 2, 128, i * 6);
+    }
+    overlay.fill(GRB(0x40c020));
+    disabled.fill(GRB(0xffffff));
+    compositor.fill(GRB(0x102030));
+    // the generator ending after the last pixel is clipped
+    assert(compositor.add(base, BlendMode::NORMAL, 255, 2, 30) == 0);
+    assert(compositor.add(overlay, BlendMode::ADD, 100, 5) == 1);
+    assert(compositor.add(gradient, BlendMode::MAX, 200, 20) == 2);
+    assert(compositor.add(disabled, BlendMode::NORMAL, 255, 30) == 3);
+    assert(compositor.add(disabled) == -1);
+    compositor.layer(3).enabled = false;
+
+    uint8_t composed[kNumPixels * 3];
+    uint8_t sent[kNumPixels * 3];
+    for(int step = 0; step < 2; step++) {
+        if (step == 1) {
+            // multiply all pixels with a partial opacity
+            compositor.clear();
+            assert(compositor.add(gradient, BlendMode::MAX, 200, 20) == 0);
+            assert(compositor.add(base, BlendMode::NORMAL, 77, 2, 30) == 1);
+            assert(compositor.add(shade, BlendMode::MULTIPLY, 180) == 2);
+            assert(compositor.add(overlay, BlendMode::ADD, 255, 30) == 3);
+        }
+        PixelData<kNumPixels, GRB> pixels;
+        compositor.compose(pixels);
+        for(uint16_t brightness: { 256, 129, 1, 0 }) {
+            drain(PixelSource<GRB>(reinterpret_cast<const uint8_t *>(pixels.data()), sizeof(composed), brightness), composed);
+            drain(compositor.getSource(brightness), sent);
+            assert(memcmp(composed, sent, sizeof(sent)) == 0);
+        }
+        for(uint16_t i = 0; i < kNumPixels; i++) {
+            assert(pixels[i].toRGB() == compositor.get(i).toRGB());
+        }
+        if (step == 0) {
+            // pixels outside all layers have the background color
+            assert(pixels[0].toRGB() == 0x102030 && pixels[1].toRGB() == 0x102030);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,205 @@
+// cycle budget model of the bit banging loop
+//
+// the constants of BitBang are estimates and can only be verified by measuring the loop on the hardware. the
+// simulation charges the same constants where _espShow() and _espShowSource() execute the code, so it does not
+// validate the constants. it checks that getCyclesHigh(), getCyclesLow() and getCyclesLowSource() match the
+// structure of the loop including the wait loops, and that meetsTiming() implies that no edge is late and no frame
+// is aborted
+#include "NeoPixelEspEx.h"
+#include <cassert>
+#include <vector>
+
+using namespace NeoPixelEx;
+using namespace NeoPixelEx::BitBang;
+
+struct Result {
+    uint32_t maxHigh0 = 0;
+    uint32_t minHigh0 = ~0U;
+    uint32_t maxLow = 0;
+    bool aborted = false;
+    // T0H/T1H was over before the first check
+    bool lateHigh = false;
+};
+
+// simulates the loop with the costs of the model. each iteration of a wait loop reads the cycle counter and takes
+// kCyclesPoll, the output changes after the loop exits. cyclesLoad < 0 simulates _espShow(), otherwise
+// _espShowSource() with load() taking cyclesLoad
+template<typename _Timings>
+static Result simulate(uint8_t features, const std::vector<uint8_t> &data, uint32_t t0, uint32_t t1, uint32_t period, int cyclesLoad, bool timeout = true)
+{
+    Result result;
+    bool source = cyclesLoad >= 0;
+    uint32_t gpio = getCyclesGpio(features);
+    uint32_t slack = _Timings::kNanosToCycles(600);
+    uint32_t slackHigh = _Timings::kNanosToCycles(300);
+    uint32_t cycles = 1000;
+    uint32_t start = 0;
+    uint32_t read = 0;
+    uint32_t lowEdge = 0;
+    size_t index = 0;
+    uint8_t pixel = data[index++];
+    uint8_t mask = 0x80;
+    auto wait = [&](uint32_t time) {
+        bool first = true;
+        for(;;) {
+            read = cycles;
+            cycles += kCyclesPoll;
+            if (read - start >= time) {
+                break;
+            }
+            first = false;
+        }
+        return first && read - start > time;
+    };
+    for(;;) {
+        uint32_t t = (pixel & mask) ? t1 : t0;
+        if (features & kInterrupts) {
+            cycles += kCyclesLowInterrupts;
+            if (timeout && start && cycles - start > period + slack) {
+                result.aborted = true;
+                break;
+            }
+        }
+        if (start) {
+            wait(period);
+            result.maxLow = std::max(result.maxLow, cycles - lowEdge);
+        }
+        else {
+            read = cycles;
+            cycles += kCyclesPoll;
+        }
+        uint32_t highEdge = cycles;
+        start = read;
+        cycles += gpio + kCyclesHighBit;
+        if (!(mask >>= 1)) {
+            cycles += kCyclesHighByte + ((!source && (features & kReOrder)) ? kCyclesHighReOrder : 0);
+            if (index < data.size()) {
+                mask = 0x80;
+            }
+        }
+        if (wait(t)) {
+            result.lateHigh = true;
+        }
+        lowEdge = cycles;
+        if (t == t0) {
+            result.maxHigh0 = std::max(result.maxHigh0, lowEdge - highEdge);
+            result.minHigh0 = std::min(result.minHigh0, lowEdge - highEdge);
+        }
+        cycles += gpio;
+        if (timeout && (features & kInterrupts) && read - start > t + slackHigh) {
+            result.aborted = true;
+            break;
+        }
+        cycles += kCyclesLowBit;
+        if (mask == 0) {
+            break;
+        }
+        if (mask == 0x80) {
+            if (source) {
+                cycles += cyclesLoad;
+            }
+            else {
+                cycles += kCyclesLowByte + ((features & kBrightness) ? kCyclesLowBrightness : 0) + ((features & kReOrder) ? kCyclesLowReOrder : 0);
+            }
+            pixel = data[index++];
+        }
+    }
+    return result;
+}
+
+template<typename _Timings>
+static void check(const char *name)
+{
+    std::vector<uint8_t> data = { 0x00, 0xff, 0x55, 0xaa, 0x01, 0x80, 0xff, 0xff, 0x00 };
+    for(uint8_t features = 0; features < 16; features++) {
+        // without timings the time between the edges are the cycles of the model
+        auto zero = simulate<_Timings>(features, data, 0, 0, 0, -1, false);
+        assert(zero.maxHigh0 == getCyclesHigh(features));
+        // the model includes the delay of the end of T1H by one iteration of the wait loop
+        assert(zero.maxLow + kCyclesPoll == getCyclesLow(features));
+        auto result = simulate<_Timings>(features, data, _Timings::kCyclesT0H, _Timings::kCyclesT1H, _Timings::kCyclesPeriod, -1);
+        bool fits = _Timings::meetsTiming(features);
+        // 0 bits are only extended by the wait loop and no frame is aborted
+        if (fits) {
+            assert(!result.lateHigh && !result.aborted && result.maxHigh0 < _Timings::kCyclesT0H + kCyclesPoll && result.minHigh0 >= _Timings::kCyclesT0H);
+        }
+        else {
+            assert(result.lateHigh || zero.maxLow + kCyclesPoll > _Timings::kCyclesMaxLoad);
+        }
+        // adding features never makes the loop faster
+        for(uint8_t more = 0; more < 16; more++) {
+            assert(!_Timings::meetsTiming(features | more) || fits);
+        }
+
+        // output sources
+        for(int cyclesLoad: { 3, 20, 40, 60, 80 }) {
+            auto zero = simulate<_Timings>(features, data, 0, 0, 0, cyclesLoad, false);
+            assert(zero.maxHigh0 == getCyclesHigh(features & ~(kReOrder | kBrightness)));
+            assert(zero.maxLow + kCyclesPoll == getCyclesLowSource(features, cyclesLoad));
+            auto result = simulate<_Timings>(features, data, _Timings::kCyclesT0H, _Timings::kCyclesT1H, _Timings::kCyclesPeriod, cyclesLoad);
+            if (_Timings::meetsTimingSource(features, cyclesLoad)) {
+                assert(!result.lateHigh && !result.aborted);
+            }
+        }
+        printf("%s %3u MHz features %02x high %2u/%2u low %2u/%3u %s%s\n", name, _Timings::kFCpu, features, getCyclesHigh(features), _Timings::kCyclesT0H,
+            getCyclesLow(features), _Timings::kCyclesMaxLoad, fits ? "ok" : "FAIL", result.aborted ? " aborted" : "");
+    }
+    // the richest set that fits, reordering is dropped first
+    uint8_t selected = _Timings::selectFeatures(kInterrupts | kGpio16, kBrightness | kReOrder);
+    assert(_Timings::meetsTiming(selected) || selected == (kInterrupts | kGpio16));
+    printf("%s %u MHz GPIO16 selected features %02x\n", name, _Timings::kFCpu, selected);
+}
+
+// cursor without an estimate
+class UnknownMask {
+public:
+    struct Cursor {
+        uint32_t next() {
+            return 0x10000;
+        }
+    };
+
+    using cursor_type = Cursor;
+
+    cursor_type getCursor(uint32_t) const {
+        return cursor_type();
+    }
+};
+
+struct Generator {
+    GRB operator()(uint16_t) {
+        return GRB(0);
+    }
+};
+
+int main()
+{
+    check<_TimingsWS2811<80>>("WS2811");
+    check<_TimingsWS2812<80>>("WS2812");
+    check<_TimingsWS2813<80>>("WS2813");
+    check<_TimingsWS2811<160>>("WS2811");
+    check<_TimingsWS2812<160>>("WS2812");
+    check<_TimingsWS2813<160>>("WS2813");
+    // the low time is exceeded before T0H
+    check<Timings<500, 1250, 1250, 50, 0, 60>>("tight ");
+    static_assert(TimingsWS2812::meetsTiming(getFeatures(2, false)), "");
+    static_assert(_TimingsWS2813<80>::selectFeatures(kGpio16, kReOrder) == kGpio16, "");
+
+    // estimates of the sources, sources without kCyclesLoad are not checked
+    static_assert(getCyclesLoad<PixelSource<CRGB>>() > getCyclesLoad<PixelSource<GRB>>(), "");
+    static_assert(getCyclesLoad<BlendSource<GRB>>() > getCyclesLoad<PixelSource<GRB>>(), "");
+    static_assert(getCyclesLoad<MaskedPixelSource<GRB, SegmentBrightnessMask<4>>>() > getCyclesLoad<MaskedPixelSource<GRB, UniformBrightness>>(), "");
+    static_assert(getCyclesLoad<MaskedPixelSource<GRB, UnknownMask>>() == 0, "");
+    static_assert(getCyclesLoad<PaletteSource<GRB, 4>>() > getCyclesLoad<PaletteSource<GRB, 8>>(), "");
+    static_assert(getCyclesLoad<GeneratorSource<GRB, Generator>>() == 0, "");
+    // the sources of the library fit WS2812 at 80MHz on GPIO16
+    constexpr uint8_t kFeatures = getFeatures(16, false) | kInterrupts;
+    static_assert(_TimingsWS2812<80>::meetsTimingSource(kFeatures, getCyclesLoad<BlendSource<CRGB>>()), "");
+    static_assert(_TimingsWS2812<80>::meetsTimingSource(kFeatures, getCyclesLoad<MaskedPixelSource<CRGB, SegmentBrightnessMask<4>>>()), "");
+    static_assert(_TimingsWS2812<80>::meetsTimingSource(kFeatures, getCyclesLoad<PaletteSource<CRGB, 4>>()), "");
+    printf("cycles of load(): PixelSource %u, BlendSource %u, MaskedPixelSource %u/%u/%u, PaletteSource %u/%u, max. WS2812 80MHz %u\n",
+        getCyclesLoad<PixelSource<GRB>>(), getCyclesLoad<BlendSource<GRB>>(), getCyclesLoad<MaskedPixelSource<GRB, UniformBrightness>>(),
+        getCyclesLoad<MaskedPixelSource<GRB, PixelBrightnessMask<10>>>(), getCyclesLoad<MaskedPixelSource<GRB, SegmentBrightnessMask<4>>>(),
+        getCyclesLoad<PaletteSource<GRB, 8>>(), getCyclesLoad<PaletteSource<GRB, 4>>(), _TimingsWS2812<80>::kCyclesMaxLoad - getCyclesLowSource(kFeatures, 0));
+    return 0;
+}
@@ -0,0 +1,175 @@
+// frames skipped by Strip::show() with dirty tracking after modifications through the pixel data, segments and the
+// serial parser, after other frames have been sent and after aborted frames
+// flags: -DNEOPIXEL_HAVE_DIRTY_TRACKING=1
+#include "NeoPixelEspExSerial.h"
+#include <cassert>
+#include <functional>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+// stores the bytes of the last frame and counts the frames. frames are aborted if result is false
+struct RecordingOutput {
+    template<uint16_t _NumBytes, typename _Chipset>
+    using type = RecordingOutput;
+
+    static constexpr bool kBrightness = false;
+
+    static constexpr bool isValidPin(uint8_t) {
+        return true;
+    }
+
+    void begin() {}
+    void end() {}
+    void setBrightness(uint8_t) {}
+
+    template<typename _Source>
+    bool show(_Source &source, Context &context) {
+        frames++;
+        frame.clear();
+        while (source.available()) {
+            frame.push_back(source.load());
+        }
+        context.getStats().increment(result);
+        context.setLastDisplayTime(micros());
+        return result;
+    }
+
+    static std::vector<uint8_t> frame;
+    static int frames;
+    static bool result;
+};
+
+std::vector<uint8_t> RecordingOutput::frame;
+int RecordingOutput::frames;
+bool RecordingOutput::result = true;
+
+static constexpr uint16_t kNumPixels = 20;
+
+using TestStrip = Strip<12, kNumPixels, RGB, TimingsWS2812, PixelData<kNumPixels, RGB>, RecordingOutput>;
+
+// show() sends a frame
+static bool sends(TestStrip &strip, uint8_t brightness = 255)
+{
+    int frames = RecordingOutput::frames;
+    strip.show(brightness);
+    return RecordingOutput::frames != frames;
+}
+
+int main()
+{
+    setVirtualTime(1000000);
+    TestStrip strip;
+    strip.setKeepAliveInterval(0);
+    strip.fill(0);
+    assert(sends(strip) && !sends(strip));
+
+    // every modification of a segment marks the pixels between its first and last pixel
+    Segment<RGB> segment(strip.data(), 4, 5, -2);
+    std::vector<std::function<void()>> edits = {
+        [&] { segment.fill(0x010203); },
+        [&] { segment.fill(1, 2, RGB(0x040506)); },
+        [&] { segment.set(4, RGB(0x070809)); },
+        [&] { segment[3] = RGB(0x0a0b0c); },
+        [&] { *segment.begin() = RGB(0x0d0e0f); },
+        [&] { segment.scaleAll(128); },
+        [&] { segment.fadeBy(10); },
+        [&] { segment.addSaturate(RGB(0x101010)); },
+        [&] { segment.subSaturate(RGB(0x010101)); },
+        [&] { segment.blend(Segment<RGB>(strip.data(), 0, 5), 100); },
+        [&] { segment.blend16(Segment<RGB>(strip.data(), 0, 5), 30000); },
+        [&] { segment.fillRainbow(10, 20); },
+        [&] { segment.fillGradient(RGB(0xff0000), RGB(0x0000ff)); },
+        [&] { segment.fillGradient(HSV(0), HSV(128)); },
+    };
+    for(auto &edit: edits) {
+        edit();
+        assert(strip.data().getDirtyBegin() >= 4 && strip.data().getDirtyEnd() <= 13 && strip.data().isDirty());
+        assert(sends(strip) && !sends(strip));
+    }
+    // the whole range for bulk functions, a single pixel for set()
+    segment.fill(0x112233);
+    assert(strip.data().getDirtyBegin() == 4 && strip.data().getDirtyEnd() == 13);
+    assert(sends(strip) && RecordingOutput::frame[12 * 3] == 0x11 && RecordingOutput::frame[3 * 3] == 0);
+    segment.set(1, RGB(0x445566));
+    assert(strip.data().getDirtyBegin() == 10 && strip.data().getDirtyEnd() == 11);
+    assert(sends(strip) && RecordingOutput::frame[10 * 3] == 0x44);
+    segment.subSegment(3, 2).fill(RGB(0x778899));
+    assert(strip.data().getDirtyBegin() == 4 && strip.data().getDirtyEnd() == 7);
+    assert(sends(strip) && RecordingOutput::frame[4 * 3] == 0x77 && RecordingOutput::frame[6 * 3] == 0x77);
+
+    // reading through a const segment does not modify the pixels
+    const Segment<RGB> &view = segment;
+    uint32_t sum = 0;
+    for(auto &pixel: view) {
+        sum += pixel.toRGB();
+    }
+    assert(sum && view[0].toRGB() == 0x112233 && view.get(1).toRGB() == 0x445566);
+    assert(!sends(strip));
+
+    // segments of a raw pointer cannot mark the pixels
+    Segment<RGB>(strip.data().data(), 0, 4).fill(0xffffff);
+    assert(!sends(strip));
+    strip.data().markDirty();
+    assert(sends(strip) && RecordingOutput::frame[0] == 0xff);
+
+    // frames of other buffers replace the pixel data on the wire, the next show() sends the pixel data again
+    auto bytes = reinterpret_cast<const uint8_t *>(strip.data().data());
+    std::vector<uint8_t> pixels(bytes, bytes + strip.getNumBytes());
+    PixelData<kNumPixels, RGB> other;
+    other.fill(RGB(0x0000ff));
+    std::vector<std::function<void()>> frames = {
+        [&] { strip.showSource(PixelSource<RGB>(reinterpret_cast<const uint8_t *>(other.data()), strip.getNumBytes(), 256)); },
+        [&] { strip.showPixels(other.data()); },
+        [&] { strip.showBlend(strip.data(), other, 128); },
+    };
+    for(auto &frame: frames) {
+        assert(!sends(strip));
+        frame();
+        assert(RecordingOutput::frame != pixels);
+        assert(sends(strip) && RecordingOutput::frame == pixels && !sends(strip));
+    }
+
+    // pixels received by the serial parser, like the example in the README
+    SerialProtocol::Parser<RGB> parser(strip.data());
+    const uint8_t received[] = { 'N', 'X', SerialProtocol::kPixels, 5, 0, 7, 0, 0x21, 0x22, 0x23, 0xff - (2 + 5 + 7 + 0x21 + 0x22 + 0x23),
+        'N', 'X', SerialProtocol::kCommit, 0, 0, 0xff - 5 };
+    size_t size = sizeof(received);
+    assert(!sends(strip));
+    assert(parser.feed(received, size) == SerialProtocol::Result::COMMIT && size == sizeof(received));
+    assert(sends(strip) && RecordingOutput::frame[7 * 3] == 0x21 && !sends(strip));
+
+    // unchanged frames are skipped until the keep alive interval has passed since the last frame
+    TestStrip keepAlive;
+    keepAlive.setKeepAliveInterval(100);
+    keepAlive.fill(0x123456);
+    auto &stats = keepAlive.getStats();
+    uint32_t skipped = stats.getSkippedFrames();
+    assert(sends(keepAlive) && !sends(keepAlive) && !sends(keepAlive));
+    assert(stats.getSkippedFrames() == skipped + 2);
+    delay(99);
+    assert(!sends(keepAlive));
+    delay(1);
+    assert(sends(keepAlive) && !sends(keepAlive));
+    assert(stats.getSkippedFrames() == skipped + 4);
+    // a new brightness is sent
+    assert(sends(keepAlive, 128) && !sends(keepAlive, 128) && sends(keepAlive));
+    keepAlive.set(3, 0x000001);
+    assert(sends(keepAlive) && RecordingOutput::frame[3 * 3 + 2] == 1 && !sends(keepAlive));
+    assert(stats.getSkippedFrames() == skipped + 6);
+
+    // aborted frames are sent again without any changes
+    RecordingOutput::result = false;
+    keepAlive.set(4, 0x000002);
+    assert(sends(keepAlive) && sends(keepAlive));
+    RecordingOutput::result = true;
+    assert(sends(keepAlive) && RecordingOutput::frame[4 * 3 + 2] == 2 && !sends(keepAlive));
+    RecordingOutput::result = false;
+    assert(sends(keepAlive, 100));
+    RecordingOutput::result = true;
+    assert(sends(keepAlive, 100) && !sends(keepAlive, 100));
+    assert(stats.getAbortedFrames() == 3 && stats.getSkippedFrames() == skipped + 8);
+
+    clearVirtualTime();
+    return 0;
+}
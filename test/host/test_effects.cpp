@@ -0,0 +1,141 @@
+// EffectEngine frames, invalidation, render stats, the effect time and the pixels written by ChaseEffect
+// flags: -DNEOPIXEL_HAVE_DIRTY_TRACKING=1
+#include "NeoPixelEspExEffects.h"
+#include <cassert>
+
+using namespace NeoPixelEx;
+
+// strip with the interface the engine uses
+template<uint16_t _NumPixels>
+struct TestStrip {
+    using pixel_type = GRB;
+    using data_type = PixelData<_NumPixels, GRB>;
+
+    TestStrip() : shows(0), brightness(0), dirtyBegin(0), dirtyEnd(0) {
+        _data.clearDirty();
+    }
+
+    static constexpr uint16_t size() {
+        return _NumPixels;
+    }
+
+    bool canShow() const {
+        return true;
+    }
+
+    data_type &data() {
+        return _data;
+    }
+
+    void show(uint8_t value) {
+        shows++;
+        brightness = value;
+        dirtyBegin = _data.getDirtyBegin();
+        dirtyEnd = _data.getDirtyEnd();
+        _data.clearDirty();
+    }
+
+    data_type _data;
+    int shows;
+    uint8_t brightness;
+    uint16_t dirtyBegin;
+    uint16_t dirtyEnd;
+};
+
+// reports a change if changed is set
+struct TestEffect : Effect<GRB> {
+    TestEffect() : changed(false), renders(0) {}
+
+    virtual bool render(GRB *, uint16_t, effect_time_t) override {
+        renders++;
+        return changed;
+    }
+
+    bool changed;
+    int renders;
+};
+
+int main()
+{
+    // 16.16 fixed point seconds, wrapping after 65536 seconds
+    assert(microsToEffectTime(0) == 0);
+    assert(microsToEffectTime(1000000) == kEffectTimeSecond);
+    assert(microsToEffectTime(500000) == kEffectTimeSecond / 2);
+    assert(microsToEffectTime(65536000000ULL) < 16);
+    assert(static_cast<effect_time_t>(microsToEffectTime(65537000000ULL) - microsToEffectTime(65535000000ULL)) == 2 * kEffectTimeSecond);
+
+    setVirtualTime(1000000);
+    TestStrip<20> strip;
+    EffectEngine<TestStrip<20>> engine(strip);
+    TestEffect first;
+    TestEffect second;
+    assert(engine.add(first, 0, 10) && engine.add(second, 10, 10));
+    assert(!engine.add(first, 20, 1));
+
+    // added effects are invalid and rendered once
+    assert(engine.loop() && strip.shows == 1 && first.renders == 1 && second.renders == 1);
+    assert(strip.dirtyBegin == 0 && strip.dirtyEnd == 20);
+
+    // no changes, no frame
+    delay(10);
+    assert(!engine.loop() && strip.shows == 1 && first.renders == 2 && second.renders == 2);
+    assert(!strip.data().isDirty());
+
+    // only the range of the changed effect is marked
+    second.changed = true;
+    delay(10);
+    assert(engine.loop() && strip.shows == 2 && strip.dirtyBegin == 10 && strip.dirtyEnd == 20);
+    second.changed = false;
+
+    // invalidate() forces a frame without changes
+    engine.invalidate();
+    delay(10);
+    assert(engine.loop() && strip.shows == 3 && strip.dirtyBegin == 0 && strip.dirtyEnd == 20);
+    assert(!engine.loop() && strip.shows == 3);
+
+    // a new brightness invalidates all effects
+    engine.setBrightness(128);
+    assert(engine.loop() && strip.shows == 4 && strip.brightness == 128);
+    engine.setBrightness(128);
+    assert(!engine.loop() && strip.shows == 4);
+
+    // renders vs. skipped frames per effect
+    assert(first.getStats().getRenders() == 3 && first.getStats().getSkipped() == 4);
+    assert(second.getStats().getRenders() == 4 && second.getStats().getSkipped() == 3);
+
+    // the engine time follows micros()
+    engine.resetTime();
+    delay(1500);
+    engine.loop();
+    assert(engine.getTime() == microsToEffectTime(1500000));
+    clearVirtualTime();
+
+    // ChaseEffect writes the background once after invalidate() and then only the previous and the current pixel
+    static constexpr uint16_t kNumPixels = 30;
+    static constexpr uint32_t kMarker = 0x123456;
+    const GRB color(0xff0000);
+    const GRB background(0x000010);
+    ChaseEffect<GRB> chase(color, background, 30);
+    PixelData<kNumPixels, GRB> pixels;
+    assert(chase.update(pixels.data(), kNumPixels, 0));
+    for(uint16_t i = 0; i < kNumPixels; i++) {
+        assert(pixels[i].toRGB() == (i == 0 ? color : background).toRGB());
+        pixels[i] = GRB(kMarker);
+    }
+    // same position, nothing is written
+    assert(!chase.update(pixels.data(), kNumPixels, kEffectTimeSecond / 60));
+    for(uint16_t i = 0; i < kNumPixels; i++) {
+        assert(pixels[i].toRGB() == kMarker);
+    }
+    // 5 pixels after 1/6 second
+    assert(chase.update(pixels.data(), kNumPixels, kEffectTimeSecond / 6 + 1));
+    for(uint16_t i = 0; i < kNumPixels; i++) {
+        assert(pixels[i].toRGB() == (i == 0 ? background.toRGB() : i == 5 ? color.toRGB() : kMarker));
+    }
+    // wraps around at the end of the strip
+    assert(chase.update(pixels.data(), kNumPixels, kEffectTimeSecond + kEffectTimeSecond / 30 + 1));
+    assert(pixels[5].toRGB() == background.toRGB() && pixels[1].toRGB() == color.toRGB());
+    assert(pixels[0].toRGB() == background.toRGB() && pixels[2].toRGB() == kMarker);
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+// HSV conversion, gradients with falling channels and a fillRainbow() benchmark against FastLED
+#include "NeoPixelEspEx.h"
+#include <cassert>
+#include <chrono>
+#include <cmath>
+
+using namespace NeoPixelEx;
+
+#if __has_include(<FastLED.h>)
+#   include <FastLED.h>
+#   define HAVE_FASTLED 1
+#else
+#   define HAVE_FASTLED 0
+#endif
+
+#if !HAVE_FASTLED
+
+// FastLED hsv2rgb_raw_C() (3 sections, hue 0-191), used as reference if FastLED is not installed
+static void fastledRaw(uint8_t hue, uint8_t saturation, uint8_t value, uint8_t &red, uint8_t &green, uint8_t &blue)
+{
+    uint8_t floor = (value * (255 - saturation)) >> 8;
+    uint8_t amplitude = value - floor;
+    uint8_t section = hue >> 6;
+    uint8_t offset = hue & 0x3f;
+    uint8_t rampUp = ((offset * amplitude) >> 6) + floor;
+    uint8_t rampDown = (((0x3f - offset) * amplitude) >> 6) + floor;
+    switch(section) {
+        case 0:
+            red = rampDown;
+            green = rampUp;
+            blue = floor;
+            break;
+        case 1:
+            red = floor;
+            green = rampDown;
+            blue = rampUp;
+            break;
+        default:
+            red = rampUp;
+            green = floor;
+            blue = rampDown;
+            break;
+    }
+}
+
+static void fastledFillRainbow(GRB *pixels, int numPixels, uint8_t hue, uint8_t deltaHue)
+{
+    uint8_t red, green, blue;
+    for(int i = 0; i < numPixels; i++, hue += deltaHue) {
+        fastledRaw(static_cast<uint8_t>((hue * 192) >> 8), 255, 255, red, green, blue);
+        pixels[i] = GRB(red, green, blue);
+    }
+}
+
+#endif
+
+// floating point hsv to rgb
+static uint32_t referenceHSV(uint8_t h, uint8_t s, uint8_t v)
+{
+    double hue = h * 6.0 / 256.0;
+    double sat = s / 255.0;
+    double val = v / 255.0;
+    double fraction = hue - std::floor(hue);
+    double p = val * (1 - sat);
+    double q = val * (1 - sat * fraction);
+    double t = val * (1 - sat * (1 - fraction));
+    double rgb[3];
+    switch(static_cast<int>(hue)) {
+        case 0: rgb[0] = val; rgb[1] = t; rgb[2] = p; break;
+        case 1: rgb[0] = q; rgb[1] = val; rgb[2] = p; break;
+        case 2: rgb[0] = p; rgb[1] = val; rgb[2] = t; break;
+        case 3: rgb[0] = p; rgb[1] = q; rgb[2] = val; break;
+        case 4: rgb[0] = t; rgb[1] = p; rgb[2] = val; break;
+        default: rgb[0] = val; rgb[1] = p; rgb[2] = q; break;
+    }
+    return (lround(rgb[0] * 255) << 16) | (lround(rgb[1] * 255) << 8) | lround(rgb[2] * 255);
+}
+
+static int maxChannelError(uint32_t a, uint32_t b)
+{
+    int error = 0;
+    for(int shift = 0; shift < 24; shift += 8) {
+        error = std::max(error, std::abs(static_cast<int>((a >> shift) & 0xff) - static_cast<int>((b >> shift) & 0xff)));
+    }
+    return error;
+}
+
+int main()
+{
+    assert(HSV(0).toRGB() == 0xff0000);
+    assert(HSV(0, 0, 77).toRGB() == 0x4d4d4d);
+    int maxError = 0;
+    for(int h = 0; h < 256; h++) {
+        for(int s = 0; s < 256; s += 15) {
+            for(int v = 0; v < 256; v += 15) {
+                maxError = std::max(maxError, maxChannelError(HSV(h, s, v).toRGB(), referenceHSV(h, s, v)));
+            }
+        }
+    }
+    printf("max. error HSV::toRGB() %d\n", maxError);
+    assert(maxError <= 2);
+
+    // falling channels have a negative delta
+    PixelData<10> pd;
+    pd.fillGradient(0xff00ff, 0x00ff00);
+    assert(pd[0].toRGB() == 0xff00ff && pd[9].toRGB() == 0x00ff00);
+    for(int i = 1; i < 10; i++) {
+        assert(pd[i].red() < pd[i - 1].red() && pd[i].green() > pd[i - 1].green() && pd[i].blue() < pd[i - 1].blue());
+        int fall = 255 - (255 * i + 4) / 9;
+        assert(maxChannelError(pd[i].toRGB(), (fall << 16) | ((255 - fall) << 8) | fall) <= 1);
+    }
+    pd.fillGradient(HSV(0, 255, 255), HSV(0, 0, 0));
+    assert(pd[0].toRGB() == 0xff0000 && pd[9].toRGB() == 0);
+    for(int i = 1; i < 10; i++) {
+        assert(pd[i].red() <= pd[i - 1].red());
+    }
+    pd.fill(GRB(0xff0000));
+    pd.fillGradient(2, 5, GRB(0xffffff), GRB(0));
+    assert(pd[2].toRGB() == 0xffffff && pd[6].toRGB() == 0 && pd[1].toRGB() == 0xff0000 && pd[7].toRGB() == 0xff0000);
+
+    // benchmark
+    static constexpr int kPixels = 1000;
+    static constexpr int kLoops = 5000;
+    PixelData<kPixels> big;
+    uint32_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < kLoops; i++) {
+        big.fillRainbow(i, 3);
+        sum += big[i % kPixels].red();
+    }
+    double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("fillRainbow() %.2f ns/pixel\n", time / (kPixels * kLoops));
+
+    #if HAVE_FASTLED
+        CRGB leds[kPixels];
+    #else
+        GRB *leds = big.data();
+    #endif
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < kLoops; i++) {
+        #if HAVE_FASTLED
+            fill_rainbow(leds, kPixels, i, 3);
+        #else
+            fastledFillRainbow(leds, kPixels, i, 3);
+        #endif
+        sum += leds[i % kPixels].r;
+    }
+    time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("%s %.2f ns/pixel (%u)\n", HAVE_FASTLED ? "FastLED fill_rainbow()" : "FastLED hsv2rgb_raw_C() reference", time / (kPixels * kLoops), sum);
+    return 0;
+}
@@ -0,0 +1,122 @@
+// I2S bit encoding of Strip::show() decoded in the order the ESP8266 I2S unit sends the 32 bit words
+#include "NeoPixelEspExI2S.h"
+#include <cassert>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+// bytes as sent by the bit banging output. brightness 1-256, 0 = black
+template<typename _PixelType>
+static std::vector<uint8_t> reference(const uint8_t *pixels, size_t size, uint8_t brightness)
+{
+    uint16_t scale = brightness ? brightness + 1 : 0;
+    std::vector<uint8_t> result;
+    uint8_t offset = 1;
+    for(size_t i = 0; i < size; i++) {
+        uint8_t value = _PixelType::kReOrder ? _PixelType::OrderType::get(pixels + i, offset) : pixels[i];
+        if (_PixelType::kReOrder) {
+            offset = (offset == sizeof(_PixelType) - 1) ? 0 : offset + 1;
+        }
+        result.push_back((value * scale) >> 8);
+    }
+    return result;
+}
+
+// the data is read as little endian 32 bit words, each word is sent MSB first with 4 I2S bits per bit
+static std::vector<uint8_t> decode(const uint16_t *words, size_t count)
+{
+    assert(count % 2 == 0);
+    std::vector<uint8_t> result;
+    uint8_t value = 0;
+    int bits = 0;
+    for(size_t i = 0; i < count; i += 2) {
+        uint32_t word;
+        memcpy(&word, &words[i], sizeof(word));
+        for(int j = 7; j >= 0; j--) {
+            uint8_t symbol = (word >> (j * 4)) & 0xf;
+            assert(symbol == 0x8 || symbol == 0xe);
+            value = (value << 1) | (symbol == 0xe);
+            if (++bits == 8) {
+                result.push_back(value);
+                value = 0;
+                bits = 0;
+            }
+        }
+    }
+    return result;
+}
+
+// encodes the frame like I2SDma
+struct EncodingOutput {
+    template<uint16_t _NumBytes, typename _Chipset>
+    struct type {
+        static constexpr bool kBrightness = false;
+
+        static constexpr bool isValidPin(uint8_t pin) {
+            return pin == 3;
+        }
+
+        void begin() {}
+        void end() {}
+
+        template<typename _Source>
+        bool show(_Source &source, Context &) {
+            words.assign(_NumBytes * 2, 0xffff);
+            auto end = I2S::encode(words.data(), source);
+            assert(end == words.data() + words.size());
+            sent = decode(words.data(), words.size());
+            return true;
+        }
+
+        std::vector<uint16_t> words;
+        std::vector<uint8_t> sent;
+    };
+};
+
+template<typename _PixelType>
+static void check()
+{
+    uint8_t pixels[30 * sizeof(_PixelType)];
+    for(auto &byte: pixels) {
+        byte = rand();
+    }
+    for(int brightness: { 0, 1, 127, 255 }) {
+        Strip<3, 30, _PixelType, TimingsWS2812, DataWrapper<30, _PixelType>, EncodingOutput> strip(pixels);
+        strip.begin();
+        strip.show(brightness);
+        assert(strip.getOutput().sent == reference<_PixelType>(pixels, sizeof(pixels), brightness));
+    }
+}
+
+int main()
+{
+    assert(I2S::encodeNibble(0) == 0x8888 && I2S::encodeNibble(0xf) == 0xeeee && I2S::encodeNibble(0xa) == 0xe8e8);
+
+    // 0x1f is sent as 0001 1111, the high nibble is the upper half of the 32 bit word
+    struct Byte {
+        bool available() {
+            return !done;
+        }
+
+        uint8_t load() {
+            done = true;
+            return 0x1f;
+        }
+
+        bool done = false;
+    } byte;
+    uint16_t words[2];
+    I2S::encode(words, byte);
+    assert(words[0] == 0xeeee && words[1] == 0x888e);
+
+    srand(7);
+    check<GRB>();
+    check<RGB>();
+    check<CRGB>();
+
+    using Divider = I2S::ClockDivider<TimingsWS2812>;
+    static_assert(Divider::kBckDiv * Divider::kClkmDiv == 50, "");
+    using Divider2811 = I2S::ClockDivider<TimingsWS2811>;
+    static_assert(Divider2811::kBckDiv * Divider2811::kClkmDiv == 100, "");
+    return 0;
+}
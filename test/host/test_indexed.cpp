@@ -0,0 +1,101 @@
+// IndexedPixelData, PaletteSource and Strip::clear() with palette data
+#include "NeoPixelEspEx.h"
+#include <cassert>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+// stores the bytes of the last frame
+struct RecordingOutput {
+    template<uint16_t _NumBytes, typename _Chipset>
+    using type = RecordingOutput;
+
+    static constexpr bool kBrightness = false;
+
+    static constexpr bool isValidPin(uint8_t) {
+        return true;
+    }
+
+    void begin() {}
+    void end() {}
+
+    template<typename _Source>
+    bool show(_Source &source, Context &) {
+        frame.clear();
+        while (source.available()) {
+            frame.push_back(source.load());
+        }
+        return true;
+    }
+
+    static std::vector<uint8_t> frame;
+};
+
+std::vector<uint8_t> RecordingOutput::frame;
+
+template<typename _Data>
+static void check(_Data &data)
+{
+    srand(3);
+    for(int i = 0; i < data.kPaletteSize; i++) {
+        data.setPalette(i, GRB(rand() | 0x010101));
+    }
+    for(int i = 0; i < 3000; i++) {
+        data.set(i, rand());
+    }
+    for(int brightness: { 0, 1, 128, 255 }) {
+        uint16_t scale = brightness ? brightness + 1 : 0;
+        auto source = data.getSource(scale);
+        int n = 0;
+        while (source.available()) {
+            auto color = data.get(n / 3);
+            auto bytes = reinterpret_cast<const uint8_t *>(&color);
+            assert(source.load() == ((bytes[n % 3] * scale) >> 8));
+            n++;
+        }
+        assert(n == 9000);
+    }
+
+    data.fill(10, 5, 3);
+    assert(data.getIndex(10) == 3 && data.getIndex(14) == 3);
+
+    // rotating past the end of the palette is clamped
+    auto palette = data.palette();
+    data.rotatePalette(data.kPaletteSize - 2, 100);
+    assert(data.palette()[data.kPaletteSize - 2].toRGB() == palette[data.kPaletteSize - 1].toRGB());
+    assert(data.palette()[data.kPaletteSize - 1].toRGB() == palette[data.kPaletteSize - 2].toRGB());
+    data.rotatePalette(data.kPaletteSize - 1);
+    data.rotatePalette(255, 10);
+    data.rotatePalette();
+    assert(data.palette()[0].toRGB() == palette[1].toRGB());
+
+    // fill() uses the closest entry, clear() black
+    data.setPalette(1, 0x010101);
+    data.fill(GRB(0));
+    assert(data.getIndex(5) == 1);
+    data.clear();
+    assert(data.get(0).toRGB() == 0 && data.get(2999).toRGB() == 0);
+}
+
+Strip<12, 3000, GRB, TimingsWS2812, IndexedPixelData<3000, 4>, RecordingOutput> strip4;
+Strip<12, 3000, GRB, TimingsWS2812, IndexedPixelData<3000, 8>, RecordingOutput> strip8;
+
+int main()
+{
+    check(strip4.data());
+    check(strip8.data());
+
+    // the palette has no black, the next frame after clear() must still be black
+    for(int i = 0; i < 16; i++) {
+        strip4.data().setPalette(i, GRB(0x202020 + i));
+    }
+    strip4.data().fill(5);
+    strip4.clear();
+    assert(RecordingOutput::frame.size() == 9000);
+    strip4.show(255);
+    assert(RecordingOutput::frame.size() == 9000);
+    for(auto value: RecordingOutput::frame) {
+        assert(value == 0);
+    }
+    return 0;
+}
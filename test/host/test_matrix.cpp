@@ -0,0 +1,51 @@
+// matrix index maps for all layouts and the LED order of MatrixSource
+// the index map is defined out of class before C++17, which requires the ODR use below to link
+// flags: -std=gnu++14
+#include "NeoPixelEspExMatrix.h"
+#include <cassert>
+
+using namespace NeoPixelEx;
+
+// maps all pixels of odd rows to the first LED of the row
+struct BrokenLayout {
+    static constexpr uint16_t index(uint16_t x, uint16_t y, uint16_t width, uint16_t) {
+        return y * width + ((y & 1) ? 0 : x);
+    }
+};
+
+template<typename _Matrix>
+static void check()
+{
+    using pixel_type = typename _Matrix::pixel_type;
+    _Matrix matrix;
+    for(int i = 0; i < _Matrix::kNumPixels; i++) {
+        matrix[i] = pixel_type(i * 3, i * 5, i * 7);
+    }
+    const uint16_t *index = _Matrix::kIndexMap.index;
+    for(int y = 0; y < _Matrix::kHeight; y++) {
+        for(int x = 0; x < _Matrix::kWidth; x++) {
+            assert(index[_Matrix::ledIndex(x, y)] == _Matrix::XY(x, y));
+        }
+    }
+    auto source = matrix.getSource(256);
+    int n = 0;
+    while (source.available()) {
+        auto color = matrix[index[n / 3]];
+        assert(source.load() == reinterpret_cast<const uint8_t *>(&color)[n % 3]);
+        n++;
+    }
+    assert(n == _Matrix::kNumPixels * 3);
+}
+
+int main()
+{
+    static_assert(SerpentineLayout::index(0, 1, 8, 4) == 15, "");
+    static_assert(Matrix<8, 4>::kIndexMap.index[15] == 8, "");
+    static_assert(!MatrixIndexMap<8, 4, BrokenLayout>().isValid(), "");
+    check<Matrix<8, 4>>();
+    check<Matrix<5, 3, RowMajorLayout>>();
+    check<Matrix<6, 4, ColumnMajorLayout>>();
+    check<Matrix<6, 4, ColumnSerpentineLayout, RGB>>();
+    check<Matrix<16, 16, TiledLayout<8, 8, SerpentineLayout, SerpentineLayout>>>();
+    return 0;
+}
@@ -0,0 +1,202 @@
+// DDP, E1.31 and Art-Net packets sent over UDP on the loopback interface and passed to Network::Receiver
+#include "NeoPixelEspExNetwork.h"
+#include <cassert>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace NeoPixelEx;
+
+static int shows;
+
+// strip with the interface the receiver uses
+template<uint16_t _NumPixels, typename _PixelType, typename _DataType = PixelData<_NumPixels, _PixelType>>
+struct TestStrip {
+    using pixel_type = _PixelType;
+    using data_type = _DataType;
+
+    template<typename ..._Args>
+    TestStrip(_Args &&...args) : _data(std::forward<_Args &&>(args)...) {}
+
+    data_type &data() {
+        return _data;
+    }
+
+    static constexpr uint16_t getNumPixels() {
+        return _NumPixels;
+    }
+
+    pixel_type get(int index) {
+        return _data[index];
+    }
+
+    void show(uint8_t) {
+        shows++;
+    }
+
+    data_type _data;
+};
+
+class Loopback {
+public:
+    Loopback() {
+        _rx = socket(AF_INET, SOCK_DGRAM, 0);
+        _tx = socket(AF_INET, SOCK_DGRAM, 0);
+        assert(_rx >= 0 && _tx >= 0);
+        sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        assert(bind(_rx, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+        socklen_t len = sizeof(_addr);
+        assert(getsockname(_rx, reinterpret_cast<sockaddr *>(&_addr), &len) == 0);
+    }
+
+    ~Loopback() {
+        close(_rx);
+        close(_tx);
+    }
+
+    // send the packet and receive it into buffer
+    size_t transfer(const uint8_t *packet, size_t length, uint8_t *buffer, size_t size) {
+        assert(sendto(_tx, packet, length, 0, reinterpret_cast<const sockaddr *>(&_addr), sizeof(_addr)) == static_cast<ssize_t>(length));
+        auto received = recv(_rx, buffer, size, 0);
+        assert(received == static_cast<ssize_t>(length));
+        return received;
+    }
+
+private:
+    int _rx;
+    int _tx;
+    sockaddr_in _addr;
+};
+
+static std::vector<uint8_t> artNet(uint16_t universe, const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> packet = { 'A', 'r', 't', '-', 'N', 'e', 't', 0, 0x00, 0x50, 0, 14, 1, 0 };
+    packet.push_back(universe & 0xff);
+    packet.push_back(universe >> 8);
+    packet.push_back(data.size() >> 8);
+    packet.push_back(data.size() & 0xff);
+    packet.insert(packet.end(), data.begin(), data.end());
+    return packet;
+}
+
+static std::vector<uint8_t> e131(uint16_t universe, const std::vector<uint8_t> &data)
+{
+    std::vector<uint8_t> packet(126 + data.size());
+    memcpy(packet.data(), "\x00\x10\x00\x00" "ASC-E1.17\0\0\0", 16);
+    packet[21] = 4;
+    packet[43] = 2;
+    packet[113] = universe >> 8;
+    packet[114] = universe & 0xff;
+    packet[117] = 2;
+    packet[118] = 0xa1;
+    packet[123] = (data.size() + 1) >> 8;
+    packet[124] = (data.size() + 1) & 0xff;
+    std::copy(data.begin(), data.end(), packet.begin() + 126);
+    return packet;
+}
+
+static std::vector<uint8_t> ddp(uint32_t offset, const std::vector<uint8_t> &data, bool push)
+{
+    std::vector<uint8_t> packet = { static_cast<uint8_t>(push ? 0x41 : 0x40), 0, 0, 1,
+        static_cast<uint8_t>(offset >> 24), static_cast<uint8_t>(offset >> 16), static_cast<uint8_t>(offset >> 8), static_cast<uint8_t>(offset),
+        static_cast<uint8_t>(data.size() >> 8), static_cast<uint8_t>(data.size()) };
+    packet.insert(packet.end(), data.begin(), data.end());
+    return packet;
+}
+
+static std::vector<uint8_t> sequence(size_t length, int start)
+{
+    std::vector<uint8_t> data(length);
+    for(size_t i = 0; i < length; i++) {
+        data[i] = static_cast<uint8_t>(start + i * 7);
+    }
+    return data;
+}
+
+int main()
+{
+    Loopback loopback;
+    uint8_t buffer[1500];
+    TestStrip<200, GRB> grb;
+    TestStrip<200, RGB> rgb;
+    Network::Receiver receiver(1, 510);
+    receiver.addStrip(grb, 0);
+    receiver.addStrip(rgb, 600);
+
+    // Art-Net universe 0, channels 0-509
+    auto data = sequence(510, 0);
+    auto packet = artNet(0, data);
+    assert(receiver.process(buffer, loopback.transfer(packet.data(), packet.size(), buffer, sizeof(buffer))));
+    assert(grb.get(0).toRGB() == GRB(data[0], data[1], data[2]).toRGB());
+    assert(grb.get(169).toRGB() == GRB(data[507], data[508], data[509]).toRGB());
+    std::vector<uint8_t> sync = { 'A', 'r', 't', '-', 'N', 'e', 't', 0, 0x00, 0x52, 0, 14, 0, 0 };
+    assert(receiver.process(buffer, loopback.transfer(sync.data(), sync.size(), buffer, sizeof(buffer))));
+    assert(receiver.getStats().getSyncs() == 1 && shows == 2);
+
+    // E1.31 universe 2, channels 510-1019, the second strip starts at channel 600
+    data = sequence(510, 100);
+    packet = e131(2, data);
+    assert(receiver.process(buffer, loopback.transfer(packet.data(), packet.size(), buffer, sizeof(buffer))));
+    assert(rgb.get(0).toRGB() == RGB(data[90], data[91], data[92]).toRGB());
+
+    // DDP at channel 3
+    packet = ddp(3, { 1, 2, 3, 4, 5, 6, 7, 8, 9 }, true);
+    assert(receiver.process(buffer, loopback.transfer(packet.data(), packet.size(), buffer, sizeof(buffer))));
+    assert(grb.get(1).toRGB() == 0x010203 && grb.get(3).toRGB() == 0x070809);
+
+    // 512 channels per universe, pixel 170 spans channels 510-512. the universes can arrive in any order
+    for(int order = 0; order < 2; order++) {
+        TestStrip<400, GRB> wide;
+        Network::Receiver wideReceiver(1, 512);
+        wideReceiver.addStrip(wide, 0);
+        auto first = sequence(512, 0);
+        auto second = sequence(512, 50);
+        auto firstPacket = artNet(0, first);
+        auto secondPacket = artNet(1, second);
+        if (order) {
+            std::swap(firstPacket, secondPacket);
+        }
+        assert(wideReceiver.process(buffer, loopback.transfer(firstPacket.data(), firstPacket.size(), buffer, sizeof(buffer))));
+        assert(wideReceiver.process(buffer, loopback.transfer(secondPacket.data(), secondPacket.size(), buffer, sizeof(buffer))));
+        assert(wide.get(169).toRGB() == GRB(first[507], first[508], first[509]).toRGB());
+        assert(wide.get(170).toRGB() == GRB(first[510], first[511], second[0]).toRGB());
+        assert(wide.get(171).toRGB() == GRB(second[1], second[2], second[3]).toRGB());
+        assert(wide.get(340).toRGB() == GRB(second[508], second[509], second[510]).toRGB());
+        // E1.31 universe 3 is the same as Art-Net universe 2, channels 1024-1535. pixel 341 spans channels 1023-1025
+        auto third = sequence(512, 99);
+        packet = e131(3, third);
+        assert(wideReceiver.process(buffer, loopback.transfer(packet.data(), packet.size(), buffer, sizeof(buffer))));
+        assert(wide.get(341).toRGB() == GRB(second[511], third[0], third[1]).toRGB());
+        assert(wide.get(342).toRGB() == GRB(third[2], third[3], third[4]).toRGB());
+    }
+
+    uint8_t invalid[5] = {};
+    assert(!receiver.process(invalid, sizeof(invalid)) && receiver.getStats().getErrors() == 1);
+
+    // pixel buffers inside the receive buffer. RGB is used without copying, GRB is converted in place
+    TestStrip<10, RGB, DataWrapper<10, RGB>> zeroCopy(static_cast<void *>(buffer + 10));
+    TestStrip<10, GRB, DataWrapper<10, GRB>> inPlace(static_cast<void *>(buffer + 10));
+    Network::Receiver rgbReceiver;
+    Network::Receiver grbReceiver;
+    rgbReceiver.addStrip(zeroCopy, 0);
+    grbReceiver.addStrip(inPlace, 0);
+    data = sequence(30, 1);
+    packet = ddp(0, data, true);
+    assert(rgbReceiver.process(buffer, loopback.transfer(packet.data(), packet.size(), buffer, sizeof(buffer))));
+    assert(memcmp(buffer + 10, data.data(), data.size()) == 0);
+    for(int i = 0; i < 10; i++) {
+        assert(zeroCopy.get(i).toRGB() == RGB(data[i * 3], data[i * 3 + 1], data[i * 3 + 2]).toRGB());
+    }
+    assert(grbReceiver.process(buffer, loopback.transfer(packet.data(), packet.size(), buffer, sizeof(buffer))));
+    for(int i = 0; i < 10; i++) {
+        assert(inPlace.get(i).toRGB() == GRB(data[i * 3], data[i * 3 + 1], data[i * 3 + 2]).toRGB());
+        assert(buffer[10 + i * 3] == data[i * 3 + 1] && buffer[11 + i * 3] == data[i * 3]);
+    }
+
+    printf("packets %u, errors %u, syncs %u\n", receiver.getStats().getPackets(), receiver.getStats().getErrors(), receiver.getStats().getSyncs());
+    return 0;
+}
@@ -0,0 +1,145 @@
+// FrameQueue under load with latency percentiles and OutputTask frames sent through the output of the strip
+#include "NeoPixelEspExOutputTask.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+using Clock = std::chrono::steady_clock;
+
+// stores the bytes of the last frame and the brightness passed to the output
+template<bool _Brightness>
+struct RecordingOutput {
+    template<uint16_t _NumBytes, typename _Chipset>
+    using type = RecordingOutput;
+
+    static constexpr bool kBrightness = _Brightness;
+
+    static constexpr bool isValidPin(uint8_t) {
+        return true;
+    }
+
+    void begin() {}
+    void end() {}
+
+    void setBrightness(uint8_t value) {
+        brightness = value;
+    }
+
+    template<typename _Source>
+    bool show(_Source &source, Context &) {
+        frame.clear();
+        while (source.available()) {
+            frame.push_back(source.load());
+        }
+        return true;
+    }
+
+    static std::vector<uint8_t> frame;
+    static int brightness;
+};
+
+template<bool _Brightness>
+std::vector<uint8_t> RecordingOutput<_Brightness>::frame;
+
+template<bool _Brightness>
+int RecordingOutput<_Brightness>::brightness = -1;
+
+struct TestFrame {
+    uint32_t sequence;
+    uint32_t pixels[300];
+    Clock::time_point time;
+};
+
+static constexpr int kNumPixels = 16;
+
+template<bool _Brightness>
+static void checkOutputTask()
+{
+    using Output = RecordingOutput<_Brightness>;
+    Strip<12, kNumPixels, GRB, TimingsWS2812, PixelData<kNumPixels, GRB>, Output> strip;
+    strip.fill(GRB(0x010101));
+    OutputTask<decltype(strip)> task(strip);
+    assert(!task.process());
+
+    auto &frame = task.frame();
+    for(int i = 0; i < kNumPixels; i++) {
+        frame.pixels[i] = GRB(i * 10, 100, 200);
+    }
+    assert(task.submit(128));
+    assert(task.process() && !task.process() && task.getFrames() == 1);
+
+    // the frame is sent, not the pixels of the strip
+    assert(Output::frame.size() == kNumPixels * 3);
+    for(int i = 0; i < kNumPixels; i++) {
+        auto bytes = &Output::frame[i * 3];
+        auto expected = GRB(i * 10, 100, 200);
+        auto raw = reinterpret_cast<const uint8_t *>(&expected);
+        for(int j = 0; j < 3; j++) {
+            // outputs with kBrightness receive full scale data and the brightness
+            assert(bytes[j] == (_Brightness ? raw[j] : (raw[j] * 129) >> 8));
+        }
+    }
+    assert(Output::brightness == (_Brightness ? 128 : -1));
+}
+
+int main()
+{
+    checkOutputTask<false>();
+    checkOutputTask<true>();
+
+    FrameQueue<TestFrame> queue;
+    assert(!queue.pop());
+    queue.back().sequence = 1;
+    assert(queue.push());
+    queue.back().sequence = 2;
+    assert(!queue.push());
+    assert(queue.pop()->sequence == 2 && !queue.pop() && queue.getDropped() == 1);
+
+    // a producer thread pushes frames as fast as possible, the consumer checks that the frames are in order and
+    // not torn
+    FrameQueue<TestFrame> stress;
+    static constexpr uint32_t kFrames = 2000000;
+    std::atomic<bool> done(false);
+    std::vector<uint32_t> latency;
+    latency.reserve(kFrames);
+    auto start = Clock::now();
+    std::thread producer([&]() {
+        for(uint32_t i = 1; i <= kFrames; i++) {
+            auto &frame = stress.back();
+            frame.sequence = i;
+            std::fill(std::begin(frame.pixels), std::end(frame.pixels), i);
+            frame.time = Clock::now();
+            stress.push();
+        }
+        done = true;
+    });
+    uint32_t last = 0;
+    uint32_t received = 0;
+    for(;;) {
+        auto frame = stress.pop();
+        if (!frame) {
+            if (done && !stress.available()) {
+                break;
+            }
+            continue;
+        }
+        assert(frame->sequence > last);
+        last = frame->sequence;
+        for(auto pixel: frame->pixels) {
+            assert(pixel == frame->sequence);
+        }
+        latency.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - frame->time).count());
+        received++;
+    }
+    producer.join();
+    double time = std::chrono::duration<double>(Clock::now() - start).count();
+    assert(last == kFrames && received + stress.getDropped() == kFrames);
+    std::sort(latency.begin(), latency.end());
+    printf("pushed %.0f frames/s, received %u, dropped %u, latency p50 %uns p99 %uns p99.9 %uns max %uns\n", kFrames / time, received, stress.getDropped(),
+        latency[latency.size() / 2], latency[latency.size() * 99 / 100], latency[latency.size() * 999 / 1000], latency.back());
+    return 0;
+}
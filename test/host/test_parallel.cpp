@@ -0,0 +1,115 @@
+// bit slices of the parallel encoder against the bytes of each strip and the encoding cost of 16 strips
+#include "NeoPixelEspExParallel.h"
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+// byte i of the strip as sent by the bit banging output. brightness 1-256, 0 = black
+template<typename _PixelType>
+static uint8_t reference(const uint8_t *pixels, size_t index, uint8_t brightness)
+{
+    uint16_t scale = brightness ? brightness + 1 : 0;
+    uint8_t offset = (index + 1) % sizeof(_PixelType);
+    uint8_t value = _PixelType::kReOrder ? _PixelType::OrderType::get(pixels + index, offset) : pixels[index];
+    return (value * scale) >> 8;
+}
+
+template<uint8_t _NumLanes, typename _PixelType>
+static void check(uint16_t lanes, uint8_t brightness)
+{
+    static constexpr uint16_t kNumPixels = 37;
+    static constexpr uint16_t kChunkSize = 16;
+    static std::vector<_PixelType> pixels[16];
+    Parallel::Encoder<_NumLanes, kNumPixels, _PixelType> encoder;
+    for(int lane = 0; lane < _NumLanes; lane++) {
+        pixels[lane].resize(kNumPixels);
+        for(auto &pixel: pixels[lane]) {
+            pixel = _PixelType(rand() & 0xffffff);
+        }
+        if (lanes & (1 << lane)) {
+            encoder.setLane(lane, pixels[lane].data());
+        }
+    }
+    encoder.reset(brightness);
+    // one chunk more than required to check the samples after the end of the frame
+    size_t chunks = (kNumPixels * sizeof(_PixelType) + kChunkSize - 1) / kChunkSize + 1;
+    std::vector<uint16_t> buffer(chunks * kChunkSize * Parallel::kSamplesPerByte);
+    for(size_t i = 0; i < chunks; i++) {
+        encoder.encode(buffer.data() + i * kChunkSize * Parallel::kSamplesPerByte, kChunkSize);
+    }
+    // samples in the order they are sent, the 16 bit halves of each 32 bit word are swapped
+    std::vector<uint16_t> samples(buffer.size());
+    for(size_t i = 0; i < samples.size(); i++) {
+        samples[i] = buffer[i ^ 1];
+    }
+    for(size_t i = 0; i < kNumPixels * sizeof(_PixelType); i++) {
+        for(int lane = 0; lane < _NumLanes; lane++) {
+            uint8_t value = 0;
+            for(int bit = 0; bit < 8; bit++) {
+                auto sample = &samples[(i * 8 + bit) * Parallel::kSamplesPerBit];
+                // high for strips with data, low at the end of each bit
+                assert(((sample[0] >> lane) & 1) == ((lanes >> lane) & 1));
+                assert(!((sample[2] >> lane) & 1));
+                value = (value << 1) | ((sample[1] >> lane) & 1);
+            }
+            uint8_t expected = (lanes & (1 << lane)) ? reference<_PixelType>(reinterpret_cast<const uint8_t *>(pixels[lane].data()), i, brightness) : 0;
+            assert(value == expected);
+        }
+    }
+    for(size_t i = kNumPixels * sizeof(_PixelType) * Parallel::kSamplesPerByte; i < samples.size(); i++) {
+        assert(samples[i] == 0);
+    }
+}
+
+int main()
+{
+    // transpose8 against the bits of each byte
+    srand(13);
+    for(int loop = 0; loop < 10000; loop++) {
+        uint8_t in[8];
+        uint8_t out[8];
+        for(auto &byte: in) {
+            byte = rand();
+        }
+        Parallel::transpose8(in, out);
+        for(int bit = 0; bit < 8; bit++) {
+            for(int n = 0; n < 8; n++) {
+                assert(((out[bit] >> n) & 1) == ((in[n] >> (7 - bit)) & 1));
+            }
+        }
+    }
+
+    for(uint8_t brightness: { 0, 1, 128, 255 }) {
+        check<16, GRB>(0xffff, brightness);
+        check<16, GRB>(0xa5a5, brightness);
+        check<8, RGB>(0xff, brightness);
+        check<5, CRGB>(0x1b, brightness);
+        check<16, CRGB>(0x8001, brightness);
+    }
+
+    using Divider = Parallel::ClockDivider<TimingsWS2812>;
+    printf("WS2812 clock divider %u + %u/%u\n", Divider::kDivNum, Divider::kDivB, Divider::kDivA);
+
+    // 16 strips with 500 pixels in chunks of 16 bytes
+    static GRB pixels[16][500];
+    Parallel::Encoder<16, 500, GRB> encoder;
+    for(int lane = 0; lane < 16; lane++) {
+        encoder.setLane(lane, pixels[lane]);
+    }
+    alignas(4) static uint16_t buffer[16 * Parallel::kSamplesPerByte];
+    static constexpr int kFrames = 2000;
+    uint32_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < kFrames; frame++) {
+        encoder.reset(255);
+        while (encoder.available()) {
+            encoder.encode(buffer, 16);
+            sum += buffer[frame % (16 * Parallel::kSamplesPerByte)];
+        }
+    }
+    double time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / kFrames;
+    printf("16x500 pixels encode %.1f us/frame, %.2f ns/byte (%u)\n", time, time * 1000 / 1500, sum);
+    return 0;
+}
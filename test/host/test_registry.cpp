@@ -0,0 +1,68 @@
+// StripRegistry groups, blackout time and the fixed number of entries
+#include "NeoPixelEspEx.h"
+#include <cassert>
+
+using namespace NeoPixelEx;
+
+Strip<4, 100, GRB, _TimingsWS2812<80>> a;
+Strip<5, 300, GRB, _TimingsWS2812<80>> b;
+Strip<16, 50, CRGB, _TimingsWS2811<80>> c;
+Strip<12, 10, GRB, _TimingsWS2813<80>> d;
+
+int main()
+{
+    // initialized statically
+    auto &registry = getStripRegistry();
+    assert(registry.size() == 0);
+    a.begin();
+    b.begin();
+    c.begin();
+    d.begin();
+    // the entry of a is updated
+    a.begin();
+    assert(registry.size() == 4);
+
+    int groups = 0;
+    registry.forEachGroup([&](uint32_t entries, uint16_t numBytes, const StripRegistry::Entry &timings) {
+        groups++;
+        if (timings.cyclesT0H == _TimingsWS2812<80>::kCyclesT0H) {
+            assert(entries == 3 && numBytes == 900);
+        }
+        else if (timings.cyclesPeriod == _TimingsWS2811<80>::kCyclesPeriod) {
+            assert(entries == 4 && numBytes == 150);
+        }
+        else {
+            assert(entries == 8 && numBytes == 30);
+        }
+    });
+    assert(groups == 3);
+
+    // 900 byte WS2812, 150 byte WS2811, 30 byte WS2813 and twice the reset delay of WS2813
+    uint32_t expected = 900 * 8 * 1250 / 1000 + 150 * 8 * 2500 / 1000 + (30 * 8 * 1280 + 999) / 1000 + 280 * 2;
+    assert(registry.getBlackoutTime() == expected);
+    // the compile time bound assumes a group for each strip
+    constexpr uint32_t kBound = BlackoutTime<decltype(a), decltype(b), decltype(c), decltype(d)>::kValue;
+    static_assert(kBound == 300 * 3 * 8 * 1250 / 1000 + 100 * 3 * 8 * 1250 / 1000 + 150 * 8 * 2500 / 1000 + 308 + 280 * 2, "");
+    assert(registry.getBlackoutTime() <= kBound);
+    printf("blackout %u us, bound %u us\n", registry.getBlackoutTime(), kBound);
+
+    registry.remove(&b);
+    assert(registry.size() == 3);
+    registry.forEachGroup([&](uint32_t, uint16_t numBytes, const StripRegistry::Entry &timings) {
+        if (timings.cyclesT0H == _TimingsWS2812<80>::kCyclesT0H) {
+            assert(numBytes == 300);
+        }
+    });
+    registry.remove(&a);
+    registry.remove(&c);
+    registry.remove(&d);
+    assert(registry.size() == 0);
+
+    // strips that do not fit are not registered
+    Strip<4, 1, GRB, _TimingsWS2812<80>> strips[StripRegistry::kMaxEntries + 1];
+    for(auto &strip: strips) {
+        strip.begin();
+    }
+    assert(registry.size() == StripRegistry::kMaxEntries);
+    return 0;
+}
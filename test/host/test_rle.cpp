@@ -0,0 +1,76 @@
+// RLE animations against the raw frames and the decode cost per frame, all flash reads must be aligned
+// data/frames.rgb contains 20 frames with 50 pixels, the headers were created with scripts/rle_encode.py
+#include "NeoPixelEspExAnimation.h"
+#include <cassert>
+#include <chrono>
+#include <vector>
+#include "data/anim_delta.h"
+#include "data/anim_full.h"
+
+using namespace NeoPixelEx;
+
+static constexpr int kPixels = 50;
+static constexpr int kFrames = 20;
+
+int main()
+{
+    std::vector<uint8_t> raw(kPixels * 3 * kFrames);
+    FILE *file = fopen("data/frames.rgb", "rb");
+    assert(file && fread(raw.data(), 1, raw.size(), file) == raw.size());
+    fclose(file);
+
+    RLEPlayer<GRB> delta(animation);
+    RLEPlayer<GRB> full(anim_full);
+    assert(delta.getNumPixels() == kPixels && delta.getNumFrames() == kFrames && delta.getFrameDelay() == 20);
+    assert(full.canSendDirect() && !delta.canSendDirect());
+
+    PixelData<kPixels> a, b;
+    for(int loop = 0; loop < 2; loop++) {
+        for(int frame = 0; frame < kFrames; frame++) {
+            assert(full.getFrame() == frame);
+            auto source = full.getSource(256);
+            delta.decodeFrame(a);
+            full.decodeFrame(b);
+            for(int i = 0; i < kPixels; i++) {
+                auto color = &raw[(frame * kPixels + i) * 3];
+                GRB expected(color[0], color[1], color[2]);
+                assert(a[i].toRGB() == expected.toRGB() && b[i].toRGB() == expected.toRGB());
+            }
+            auto bytes = reinterpret_cast<const uint8_t *>(b.data());
+            int n = 0;
+            while (source.available()) {
+                assert(source.load() == bytes[n]);
+                n++;
+            }
+            assert(n == kPixels * 3);
+        }
+    }
+    full.skipFrame();
+    assert(full.getFrame() == 1);
+
+    // cost per frame
+    static constexpr int kLoops = 20000;
+    for(auto player: { &delta, &full }) {
+        player->rewind();
+        pgmReadDwordCount = 0;
+        auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < kLoops; i++) {
+            player->decodeFrame(a);
+        }
+        double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        printf("%s decodeFrame() %.0f ns/frame, %.1f flash reads/frame\n", player == &delta ? "delta" : "full ", time / kLoops, pgmReadDwordCount / static_cast<double>(kLoops));
+    }
+    full.rewind();
+    pgmReadDwordCount = 0;
+    uint32_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < kLoops; i++) {
+        auto source = full.getSource(256);
+        while (source.available()) {
+            sum += source.load();
+        }
+    }
+    double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("full  getSource() first frame %.0f ns, %.1f flash reads/frame (%u)\n", time / kLoops, pgmReadDwordCount / static_cast<double>(kLoops), sum);
+    return 0;
+}
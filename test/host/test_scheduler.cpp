@@ -0,0 +1,157 @@
+// Scheduler ordering, budget and fairness, and 3 strips at 60fps in virtual time against sending back to back
+// flags: -DNEOPIXEL_HAVE_DIRTY_TRACKING=1
+#include "NeoPixelEspExScheduler.h"
+#include <cassert>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+// virtual time of the simulation
+static uint32_t now;
+
+// strip with the interface the scheduler uses, records the times the frames are sent
+template<uint16_t _NumPixels, typename _Chipset = TimingsWS2812>
+struct TestStrip {
+    using chipset_type = _Chipset;
+    using data_type = PixelData<_NumPixels, GRB>;
+
+    static constexpr uint32_t getFrameTime() {
+        return (_NumPixels * 3 * 8UL * _Chipset::kNanosPeriod + 999) / 1000;
+    }
+
+    const data_type &data() const {
+        return _data;
+    }
+
+    data_type &data() {
+        return _data;
+    }
+
+    Stats &getStats() {
+        return _context.getStats();
+    }
+
+    void show(uint8_t) {
+        _data.clearDirty();
+        sent.push_back(now);
+        _context.getStats().increment(true);
+    }
+
+    data_type _data;
+    Context _context;
+    std::vector<uint32_t> sent;
+};
+
+struct Result {
+    uint32_t maxBlocking;
+    uint32_t maxLateness;
+    uint32_t frames[3];
+};
+
+// 3 strips rendered at 60fps for 1 second. each loop takes 0.5ms plus the time blocked by sending
+template<bool _Scheduled>
+static Result simulate(uint32_t budget)
+{
+    TestStrip<300> a;
+    TestStrip<150> b;
+    TestStrip<30> c;
+    Scheduler<4> scheduler(budget);
+    now = 0;
+    scheduler.add(a, 60, now);
+    scheduler.add(b, 60, now);
+    scheduler.add(c, 100, now);
+    Result result = {};
+    uint32_t nextRender = 0;
+    while (now < 1000000) {
+        if (static_cast<int32_t>(now - nextRender) >= 0) {
+            nextRender += 16666;
+            a.data().markDirty();
+            b.data().markDirty();
+            c.data().markDirty();
+        }
+        uint32_t blocking = 0;
+        uint32_t start = now;
+        if (_Scheduled) {
+            blocking = scheduler.run(now);
+        }
+        else {
+            if (a.data().isDirty()) {
+                a.show(255);
+                blocking += a.getFrameTime() + 85;
+            }
+            if (b.data().isDirty()) {
+                b.show(255);
+                blocking += b.getFrameTime() + 85;
+            }
+            if (c.data().isDirty()) {
+                c.show(255);
+                blocking += c.getFrameTime() + 85;
+            }
+        }
+        result.maxBlocking = std::max(result.maxBlocking, blocking);
+        now = start + 500 + blocking;
+    }
+    result.frames[0] = a.sent.size();
+    result.frames[1] = b.sent.size();
+    result.frames[2] = c.sent.size();
+    result.maxLateness = std::max({ a.getStats().getMaxLateness(), b.getStats().getMaxLateness(), c.getStats().getMaxLateness() });
+    return result;
+}
+
+int main()
+{
+    // ordering and budget. the strips take 9000 + 85, 4500 + 85 and 900 + 85us
+    {
+        TestStrip<300> a;
+        TestStrip<150> b;
+        TestStrip<30> c;
+        Scheduler<4> scheduler(10000);
+        scheduler.add(a, 50, 0);
+        scheduler.add(b, 50, 0);
+        scheduler.add(c, 50, 0);
+        now = 0;
+        // the first strip is always sent, b and c do not fit after a
+        assert(scheduler.run(0) == 9085 && a.sent.size() == 1 && b.sent.empty());
+        assert(scheduler.run(100) == 4585 + 985);
+        // nothing modified
+        assert(scheduler.run(30000) == 0);
+        // b modified. the deadline 20000 has been moved to 30000 while idle
+        b.data().markDirty();
+        assert(scheduler.getTimeUntilNext(30500) == 0);
+        assert(scheduler.run(30500) == 4585);
+        assert(b.getStats().getMaxLateness() == 500);
+        // rate limited until 30000 + 20000
+        b.data().markDirty();
+        assert(scheduler.run(31000) == 0);
+        assert(scheduler.getTimeUntilNext(31000) == 19000);
+        // a brightness change is sent without modified pixels
+        scheduler.setBrightness(&c, 10);
+        assert(scheduler.run(60000) == 4585 + 985);
+    }
+
+    // fairness: 2 strips that require more than half of the budget alternate
+    {
+        TestStrip<200> a;
+        TestStrip<200> b;
+        Scheduler<2> scheduler(7000);
+        scheduler.add(a, 1000, 0);
+        scheduler.add(b, 1000, 0);
+        for(now = 0; now < 100000; now += 1000) {
+            a.data().markDirty();
+            b.data().markDirty();
+            assert(scheduler.run(now) <= 7000);
+        }
+        assert(a.sent.size() == 50 && b.sent.size() == 50);
+    }
+
+    auto backToBack = simulate<false>(0);
+    printf("back to back: max. blocking %uus, frames %u/%u/%u\n", backToBack.maxBlocking, backToBack.frames[0], backToBack.frames[1], backToBack.frames[2]);
+    for(uint32_t budget: { 5000, 3000 }) {
+        auto result = simulate<true>(budget);
+        printf("scheduler %ums: max. blocking %uus, max. lateness %uus, frames %u/%u/%u\n", budget / 1000, result.maxBlocking, result.maxLateness, result.frames[0], result.frames[1], result.frames[2]);
+        // a frame larger than the budget is still sent alone
+        assert(result.maxBlocking <= 9085 && result.maxBlocking < backToBack.maxBlocking);
+        assert(result.frames[0] == backToBack.frames[0] && result.frames[1] == backToBack.frames[1] && result.frames[2] == backToBack.frames[2]);
+    }
+    return 0;
+}
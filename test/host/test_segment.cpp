@@ -0,0 +1,135 @@
+// segments with random offsets, lengths and steps against a reference with explicit indices
+// flags: -fsanitize=address,undefined -fno-sanitize-recover=all
+#include "NeoPixelEspEx.h"
+#include <cassert>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+static constexpr int kNumPixels = 120;
+
+PixelData<kNumPixels, GRB> buffer, reference, other, other2;
+
+// index of the pixel in the buffer
+static int pixelIndex(int offset, int numPixels, int step, int index)
+{
+    return step < 0 ? offset + (numPixels - 1 - index) * -step : offset + index * step;
+}
+
+int main()
+{
+    // pointer, offset and number of pixels selects the public constructor
+    GRB pixels[10] = {};
+    Segment<GRB> first(pixels, 0, 10);
+    assert(first.size() == 10 && first.getStep() == 1);
+
+    // reversed segment starting at the first pixel of the buffer
+    Segment<GRB> reversed(pixels, 0, 10, -1);
+    reversed.fill(GRB(0x010203));
+    int count = 0;
+    for(auto &pixel: reversed) {
+        pixel = GRB(count++);
+    }
+    assert(count == 10 && pixels[9].toRGB() == 0 && pixels[0].toRGB() == 9);
+    assert(Segment<GRB>(pixels, 0, 0, -1).begin() == Segment<GRB>(pixels, 0, 0, -1).end());
+
+    // PixelData::end() const points behind the last pixel
+    const auto &constBuffer = buffer;
+    assert(constBuffer.end() - constBuffer.begin() == kNumPixels);
+
+    srand(5);
+    for(int loop = 0; loop < 20000; loop++) {
+        for(int i = 0; i < kNumPixels; i++) {
+            buffer[i] = GRB(rand());
+            other[i] = GRB(rand());
+            other2[i] = GRB(rand());
+        }
+        reference = buffer;
+        int step = (rand() % 3 + 1) * ((rand() & 1) ? 1 : -1);
+        int numPixels = rand() % 30;
+        int offset = rand() % 20;
+        Segment<GRB> segment(buffer, offset, numPixels, step);
+        std::vector<GRB> expected(numPixels);
+        for(int i = 0; i < numPixels; i++) {
+            expected[i] = reference[pixelIndex(offset, numPixels, step, i)];
+        }
+        uint8_t amount = rand();
+        GRB color(rand());
+        GRB color2(rand());
+        switch(rand() % 9) {
+            case 0:
+                segment.fill(color);
+                std::fill(expected.begin(), expected.end(), color);
+                break;
+            case 1:
+                segment.scaleAll(amount);
+                for(auto &pixel: expected) {
+                    pixel = pixel.scale(amount);
+                }
+                break;
+            case 2:
+                segment.addSaturate(color);
+                for(auto &pixel: expected) {
+                    pixel = pixel.addSaturate(color);
+                }
+                break;
+            case 3:
+                segment.subSaturate(color);
+                for(auto &pixel: expected) {
+                    pixel = pixel.subSaturate(color);
+                }
+                break;
+            case 4:
+                segment.blend(other, amount);
+                for(int i = 0; i < numPixels; i++) {
+                    expected[i] = expected[i].blend(other[i], amount);
+                }
+                break;
+            case 5: {
+                    Segment<GRB> from(other2, 0, numPixels, -1);
+                    segment.blend(from, other, amount);
+                    for(int i = 0; i < numPixels; i++) {
+                        expected[i] = from[i].blend(other[i], amount);
+                    }
+                }
+                break;
+            case 6:
+                segment.fillRainbow(amount, 7);
+                for(int i = 0; i < numPixels; i++) {
+                    expected[i] = HSV(amount + 7 * i).toColor<GRB>();
+                }
+                break;
+            case 7:
+                segment.fillGradient(color, color2);
+                if (numPixels) {
+                    gradientPixels(expected.data(), numPixels, color, color2);
+                }
+                break;
+            case 8: {
+                    int subOffset = numPixels ? rand() % numPixels : 0;
+                    int subPixels = (numPixels - subOffset) ? rand() % (numPixels - subOffset) : 0;
+                    segment.fill(subOffset, subPixels, color);
+                    std::fill(expected.begin() + subOffset, expected.begin() + subOffset + subPixels, color);
+                }
+                break;
+        }
+        for(int i = 0; i < numPixels; i++) {
+            assert(segment[i].toRGB() == expected[i].toRGB());
+            assert(buffer[pixelIndex(offset, numPixels, step, i)].toRGB() == expected[i].toRGB());
+        }
+        count = 0;
+        for(auto &pixel: segment) {
+            assert(pixel.toRGB() == expected[count++].toRGB());
+        }
+        assert(count == numPixels);
+        // pixels outside the segment are not modified
+        for(int i = 0; i < kNumPixels; i++) {
+            bool inside = false;
+            for(int j = 0; j < numPixels; j++) {
+                inside |= pixelIndex(offset, numPixels, step, j) == i;
+            }
+            assert(inside || buffer[i].toRGB() == reference[i].toRGB());
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,139 @@
+// serial streaming protocol, one response per frame, dirty tracking, fuzzing and parser throughput
+// flags: -DNEOPIXEL_HAVE_DIRTY_TRACKING=1
+#include "NeoPixelEspExSerial.h"
+#include <cassert>
+#include <chrono>
+#include <vector>
+
+using namespace NeoPixelEx;
+using namespace NeoPixelEx::SerialProtocol;
+
+static std::vector<uint8_t> packet(uint8_t command, const std::vector<uint8_t> &payload)
+{
+    std::vector<uint8_t> result = { kMagic1, kMagic2, command, static_cast<uint8_t>(payload.size()), static_cast<uint8_t>(payload.size() >> 8) };
+    uint8_t checksum = command + static_cast<uint8_t>(payload.size()) + static_cast<uint8_t>(payload.size() >> 8);
+    for(auto byte: payload) {
+        result.push_back(byte);
+        checksum += byte;
+    }
+    result.push_back(0xff - checksum);
+    return result;
+}
+
+// responses the host would receive for data
+template<typename _Parser>
+static std::vector<Result> responses(_Parser &parser, const std::vector<uint8_t> &data)
+{
+    std::vector<Result> result;
+    for(auto byte: data) {
+        auto response = parser.feed(byte);
+        if (response != Result::NONE) {
+            result.push_back(response);
+        }
+    }
+    return result;
+}
+
+static constexpr int kGuard = 16;
+static constexpr int kNumPixels = 100;
+static constexpr uint32_t kCanary = 0x5a5a5a;
+
+int main()
+{
+    // the pixel buffer is surrounded by guard pixels
+    GRB buffer[kGuard + kNumPixels + kGuard];
+    for(auto &pixel: buffer) {
+        pixel = GRB(kCanary);
+    }
+    GRB *pixels = buffer + kGuard;
+    std::fill(pixels, pixels + kNumPixels, GRB(0));
+    Parser<GRB> parser(pixels, kNumPixels);
+
+    std::vector<uint8_t> frame = { 0x00, kMagic1 };
+    std::vector<std::vector<uint8_t>> packets = { packet(kFill, { 10, 0, 5, 0, 1, 2, 3 }), packet(kPixels, { 98, 0, 4, 5, 6, 7, 8, 9, 10, 11, 12 }),
+        packet(kPalette, { 2, 20, 21, 22 }), packet(kIndexed, { 50, 0, 2, 2 }), packet(kCommit, {}) };
+    for(auto &part: packets) {
+        frame.insert(frame.end(), part.begin(), part.end());
+    }
+    assert(responses(parser, frame) == std::vector<Result>({ Result::COMMIT }));
+    assert(pixels[10].toRGB() == 0x010203 && pixels[14].toRGB() == 0x010203 && pixels[15].toRGB() == 0);
+    assert(pixels[98].toRGB() == 0x040506 && pixels[99].toRGB() == 0x070809);
+    assert(pixels[50].toRGB() == 0x141516 && pixels[51].toRGB() == 0x141516);
+
+    // a parser of the pixel data marks the pixels it writes
+    PixelData<kNumPixels, GRB> pixelData;
+    Parser<GRB> dataParser(pixelData);
+    pixelData.clearDirty();
+    assert(responses(dataParser, packets[0]).empty() && pixelData.getDirtyBegin() == 10 && pixelData.getDirtyEnd() == 15);
+    pixelData.clearDirty();
+    assert(responses(dataParser, packets[1]).empty() && pixelData.getDirtyBegin() == 98 && pixelData.getDirtyEnd() == 100);
+    pixelData.clearDirty();
+    assert(responses(dataParser, packets[2]).empty() && !pixelData.isDirty());
+    assert(responses(dataParser, packets[3]).empty() && pixelData.getDirtyBegin() == 50 && pixelData.getDirtyEnd() == 52);
+    // fills are clipped at the end of the buffer
+    pixelData.clearDirty();
+    assert(responses(dataParser, packet(kFill, { 95, 0, 50, 0, 1, 2, 3 })).empty() && pixelData.getDirtyBegin() == 95 && pixelData.getDirtyEnd() == 100);
+    assert(responses(dataParser, packets[4]) == std::vector<Result>({ Result::COMMIT }));
+
+    // a damaged data packet is reported once with the commit
+    auto damaged = packet(kPixels, { 0, 0, 1, 1, 1 });
+    damaged.back() ^= 1;
+    auto commit = packet(kCommit, {});
+    std::vector<uint8_t> data(damaged);
+    data.insert(data.end(), damaged.begin(), damaged.end());
+    data.insert(data.end(), commit.begin(), commit.end());
+    assert(responses(parser, data) == std::vector<Result>({ Result::ERROR }));
+    assert(responses(parser, commit) == std::vector<Result>({ Result::COMMIT }));
+
+    // a damaged commit is answered with a single error as well
+    commit.back() ^= 1;
+    assert(responses(parser, commit) == std::vector<Result>({ Result::ERROR }));
+    commit.back() ^= 1;
+    assert(responses(parser, commit) == std::vector<Result>({ Result::COMMIT }));
+
+    // random bytes and random packets must not write outside the pixel buffer
+    srand(1);
+    uint32_t commits = 0;
+    uint32_t errors = 0;
+    for(int i = 0; i < 2000000; i++) {
+        parser.feed(rand());
+    }
+    for(int i = 0; i < 200000; i++) {
+        std::vector<uint8_t> payload(rand() % 40);
+        for(auto &byte: payload) {
+            byte = rand();
+        }
+        auto data = packet(rand() % 7, payload);
+        if (rand() % 8 == 0) {
+            data[rand() % data.size()] ^= 1 << (rand() % 8);
+        }
+        for(auto response: responses(parser, data)) {
+            (response == Result::COMMIT ? commits : errors)++;
+        }
+    }
+    for(int i = 0; i < kGuard; i++) {
+        assert(buffer[i].toRGB() == kCanary && buffer[kGuard + kNumPixels + i].toRGB() == kCanary);
+    }
+    printf("fuzzing frames=%u errors=%u commits=%u nak=%u\n", parser.getFrames(), parser.getErrors(), commits, errors);
+
+    // throughput of a full frame of kNumPixels
+    parser.reset();
+    std::vector<uint8_t> payload = { 0, 0 };
+    for(int i = 0; i < kNumPixels * 3; i++) {
+        payload.push_back(i);
+    }
+    data = packet(kPixels, payload);
+    commit = packet(kCommit, {});
+    data.insert(data.end(), commit.begin(), commit.end());
+    static constexpr int kLoops = 50000;
+    uint32_t frames = 0;
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < kLoops; i++) {
+        size_t size = data.size();
+        frames += parser.feed(data.data(), size) == Result::COMMIT;
+    }
+    double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    assert(frames == kLoops);
+    printf("parser %.2f ns/byte, %.1f MB/s\n", time / (kLoops * data.size()), (kLoops * data.size()) / (time / 1e3));
+    return 0;
+}
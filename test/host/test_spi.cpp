@@ -0,0 +1,101 @@
+// APA102/SK9822 framing, the 5 bit global brightness and the HSPI output of Strip
+#include "NeoPixelEspExSpi.h"
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+int main()
+{
+    // start, pixel and end frames
+    assert(Clocked::endFrameSize(1) == 4 && Clocked::endFrameSize(64) == 4 && Clocked::endFrameSize(65) == 5 && Clocked::endFrameSize(500) == 32);
+    static_assert(Clocked::frameSize<APA102<>>(10) == 4 + 40 + 4, "");
+    static_assert(Clocked::frameSize<SK9822<>>(10) == 4 + 40 + 4 + 4, "");
+    BGR pixels[5];
+    for(int i = 0; i < 5; i++) {
+        pixels[i] = BGR(10 * i + 1, 10 * i + 2, 10 * i + 3);
+    }
+    PixelSource<BGR> source(reinterpret_cast<const uint8_t *>(pixels), sizeof(pixels), 256);
+    uint8_t buffer[64];
+    memset(buffer, 0xaa, sizeof(buffer));
+    Clocked::GlobalBrightness globalBrightness;
+    auto end = Clocked::encode<SK9822<10000000, false>>(buffer, source, 5, globalBrightness);
+    assert(end - buffer == Clocked::frameSize<SK9822<>>(5));
+    for(int i = 0; i < 4; i++) {
+        assert(buffer[i] == 0);
+    }
+    for(int i = 0; i < 5; i++) {
+        auto pixel = buffer + 4 + i * 4;
+        assert(pixel[0] == 0xff && pixel[1] == 10 * i + 3 && pixel[2] == 10 * i + 2 && pixel[3] == 10 * i + 1);
+    }
+    for(auto ptr = buffer + 24; ptr < end; ptr++) {
+        assert(*ptr == 0);
+    }
+    assert(*end == 0xaa);
+
+    // global brightness: no overflow, the lowest level that can display the pixel and an error below 1 step of
+    // the level
+    double maxError = 0;
+    for(int brightness = 0; brightness < 256; brightness++) {
+        globalBrightness.set(brightness);
+        for(int max = 0; max < 256; max++) {
+            int level = globalBrightness.getLevel(max);
+            assert(level <= 31);
+            assert(level == 0 || (max * brightness * 31.0 / 65025.0) > level - 1);
+            for(int value = 0; value <= max; value++) {
+                uint32_t output = (value * static_cast<uint32_t>(globalBrightness.getScale(level)) + 128) >> 8;
+                assert(output <= 255);
+                double error = std::fabs(value * brightness / 255.0 - output * level / 31.0);
+                assert(level == 0 || error < 1.5 * level / 31.0 + 1e-9);
+                maxError = std::max(maxError, error);
+            }
+        }
+    }
+    // dark pixels keep their resolution
+    globalBrightness.set(32);
+    std::vector<int> values;
+    for(int value = 0; value < 8; value++) {
+        int level = globalBrightness.getLevel(value);
+        values.push_back(((value * globalBrightness.getScale(level) + 128) >> 8) * 1000 + level);
+    }
+    std::sort(values.begin(), values.end());
+    assert(std::unique(values.begin(), values.end()) - values.begin() >= 7);
+    printf("global brightness max. error %.3f\n", maxError);
+
+    // HSPI output with the global brightness of APA102
+    Strip<13, 100, BGR, APA102<20000000>, PixelData<100, BGR>, SpiOutput<>> strip;
+    strip.begin();
+    assert(SPI.active);
+    for(int i = 0; i < 100; i++) {
+        strip[i] = BGR(i, 2 * i, 255 - i);
+    }
+    strip.show(128);
+    assert(SPI.clock == 20000000 && SPI.data.size() == 4 + 400 + 7);
+    for(int i = 0; i < 100; i++) {
+        auto pixel = &SPI.data[4 + i * 4];
+        assert((pixel[0] & 0xe0) == 0xe0);
+        double scale = (pixel[0] & 0x1f) / 31.0;
+        assert(std::fabs(pixel[1] * scale - (255 - i) * 128 / 255.0) <= 1.0);
+        assert(std::fabs(pixel[2] * scale - (2 * i) * 128 / 255.0) <= 1.0);
+        assert(std::fabs(pixel[3] * scale - i * 128 / 255.0) <= 1.0);
+    }
+    // sources and clear() are sent at full scale
+    strip.showBlend(strip.data(), strip.data(), 0, 255);
+    assert(SPI.data[4] == (0xe0 | 31) && SPI.data[5] == 255);
+    strip.clear();
+    for(int i = 0; i < 100; i++) {
+        assert(SPI.data[4 + i * 4] == 0xe0 && SPI.data[5 + i * 4] == 0);
+    }
+    strip.end();
+    assert(!SPI.active);
+
+    // SK9822 without global brightness
+    Strip<13, 16, BGR, SK9822<10000000, false>, PixelData<16, BGR>, SpiOutput<>> sk9822;
+    sk9822.begin();
+    sk9822.fill(BGR(0xff8000));
+    sk9822.show(128);
+    assert(SPI.data.size() == 4 + 64 + 4 + 4);
+    assert(SPI.data[4] == 0xff && SPI.data[5] == 0 && SPI.data[6] == ((0x80 * 129) >> 8) && SPI.data[7] == ((0xff * 129) >> 8));
+    return 0;
+}
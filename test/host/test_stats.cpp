@@ -0,0 +1,116 @@
+// stats snapshots while another thread writes, bounded retries, window fps and the binary format
+#include "NeoPixelEspEx.h"
+#include <cassert>
+#include <chrono>
+#include <thread>
+
+using namespace NeoPixelEx;
+
+// allows to leave a write open like an interrupted writer
+class TestStats : public Stats {
+public:
+    void beginWrite() {
+        _beginWrite();
+    }
+
+    void endWrite() {
+        _endWrite();
+    }
+};
+
+struct TestStrip {
+    Stats &getStats() {
+        return stats;
+    }
+
+    Stats stats;
+};
+
+int main()
+{
+    // window fps drops after the frames stopped
+    setVirtualTime(1000000);
+    Stats window;
+    for(int i = 0; i <= 60; i++) {
+        window.increment(true);
+        delayMicroseconds(1000000 / 60);
+    }
+    assert(window.getWindowFps() >= 59 && window.getWindowFps() <= 61);
+    delay(200);
+    assert(window.getWindowFps() >= 45 && window.getWindowFps() <= 55);
+    delay(2000);
+    assert(window.getWindowFps() < 30 && window.getSnapshot().windowFps == window.getWindowFps());
+    delay(200000);
+    assert(window.getWindowFps() == 0);
+    clearVirtualTime();
+
+    // an open write ends the snapshot after kSnapshotRetries
+    TestStats open;
+    open.increment(true);
+    open.beginWrite();
+    StatsSnapshot snapshot;
+    assert(!open.getSnapshot(snapshot) && snapshot.frames == 1);
+    open.endWrite();
+    assert(open.getSnapshot(snapshot) && snapshot.frames == 1);
+
+    // a writer thread keeps frames and aborted frames equal. the writer runs without any pause first and then
+    // with 1us between the writes, which is still much more often than frames are sent. on a single CPU the writer
+    // can be preempted during a write and all retries of a snapshot fail
+    for(int pause: { 0, 1000 }) {
+        Stats stats;
+        std::atomic<bool> stop(false);
+        std::thread writer([&]() {
+            for(uint32_t i = 0; i < (pause ? 2000000 : 20000000); i++) {
+                stats.increment(false);
+                if ((i & 0xfffff) == 0) {
+                    stats.clear();
+                }
+                for(auto start = std::chrono::steady_clock::now(); std::chrono::steady_clock::now() - start < std::chrono::nanoseconds(pause); ) {
+                }
+            }
+            stop = true;
+        });
+        uint32_t reads = 0;
+        uint32_t inconsistent = 0;
+        while (!stop) {
+            if (stats.getSnapshot(snapshot)) {
+                assert(snapshot.frames == snapshot.aborted);
+            }
+            else {
+                inconsistent++;
+            }
+            reads++;
+        }
+        writer.join();
+        printf("pause %dns: snapshots %u, inconsistent %u\n", pause, reads, inconsistent);
+        assert(reads > 0 && (pause == 0 || inconsistent < reads / 4));
+    }
+
+    // binary format
+    StatsSnapshot a;
+    a.time = 99;
+    a.frames = 0x12345678;
+    a.aborted = 1;
+    a.retries = 2;
+    a.skipped = 3;
+    a.late = 4;
+    a.maxLateness = 500;
+    a.fps = 60;
+    a.windowFps = 61;
+    uint8_t buffer[StatsSnapshot::kBinarySize];
+    assert(a.toBinary(buffer, sizeof(buffer) - 1) == 0);
+    assert(a.toBinary(buffer, sizeof(buffer)) == 33);
+    assert(buffer[0] == StatsSnapshot::kVersion && buffer[1] == 99 && buffer[5] == 0x78 && buffer[8] == 0x12);
+    StatsSnapshot b;
+    assert(b.fromBinary(buffer, sizeof(buffer)));
+    assert(b.frames == a.frames && b.windowFps == 61 && b.fps == 60 && b.skipped == 3 && b.retries == 2 && b.late == 4 && b.maxLateness == 500);
+
+    TestStrip strip1, strip2;
+    strip1.stats.increment(true);
+    strip2.stats.increment(false);
+    strip2.stats.incrementRetries();
+    strip2.stats.incrementSkipped();
+    auto total = aggregateStats(strip1, strip2);
+    assert(total.frames == 2 && total.aborted == 1 && total.retries == 1 && total.skipped == 1);
+    return 0;
+}
@@ -0,0 +1,86 @@
+// parity of the SWAR kernels with the scalar Color methods
+#include "NeoPixelEspEx.h"
+#include <cassert>
+
+using namespace NeoPixelEx;
+
+int main()
+{
+    // all lanes with all combinations of 2 values
+    for(uint32_t a = 0; a < 256; a++) {
+        for(uint32_t b = 0; b < 256; b++) {
+            uint32_t wa = a | (b << 8) | ((a ^ 0x5a) << 16) | ((255 - b) << 24);
+            uint32_t wb = b | (a << 8) | (((b * 7) & 0xff) << 16) | (a << 24);
+            uint32_t added = SWAR::addSaturate(wa, wb);
+            uint32_t subtracted = SWAR::subSaturate(wa, wb);
+            uint32_t scaled = SWAR::scale(wa, b ? b + 1 : 0);
+            for(int lane = 0; lane < 4; lane++) {
+                int x = (wa >> (lane * 8)) & 0xff;
+                int y = (wb >> (lane * 8)) & 0xff;
+                assert(((added >> (lane * 8)) & 0xff) == static_cast<uint32_t>(std::min(x + y, 255)));
+                assert(((subtracted >> (lane * 8)) & 0xff) == static_cast<uint32_t>(std::max(x - y, 0)));
+                assert(((scaled >> (lane * 8)) & 0xff) == static_cast<uint32_t>(b ? (x * (b + 1)) >> 8 : 0));
+            }
+        }
+    }
+
+    // buffer functions with unaligned ranges
+    srand(1);
+    PixelData<333> a, b;
+    for(int i = 0; i < 333; i++) {
+        a[i] = GRB(rand());
+    }
+    for(int brightness: { 0, 1, 17, 128, 254, 255 }) {
+        for(int offset: { 0, 1, 2, 5 }) {
+            b = a;
+            b.scale(offset, 300, brightness);
+            for(int i = 0; i < 333; i++) {
+                assert(b[i].toRGB() == ((i >= offset && i < offset + 300) ? a[i].scale(brightness) : a[i]).toRGB());
+            }
+            GRB color(rand());
+            b = a;
+            b.addSaturate(offset, 300, color);
+            for(int i = 0; i < 333; i++) {
+                assert(b[i].toRGB() == ((i >= offset && i < offset + 300) ? a[i].addSaturate(color) : a[i]).toRGB());
+            }
+            b = a;
+            b.subSaturate(offset, 300, color);
+            for(int i = 0; i < 333; i++) {
+                assert(b[i].toRGB() == ((i >= offset && i < offset + 300) ? a[i].subSaturate(color) : a[i]).toRGB());
+            }
+            // fillN() takes the number of pixels, fill() the end index
+            b = a;
+            b.fillN(offset, 300, color);
+            for(int i = 0; i < 333; i++) {
+                assert(b[i].toRGB() == ((i >= offset && i < offset + 300) ? color : a[i]).toRGB());
+            }
+            b = a;
+            b.fill(offset, 300, color);
+            for(int i = 0; i < 333; i++) {
+                assert(b[i].toRGB() == ((i >= offset && i < 300) ? color : a[i]).toRGB());
+            }
+            b = a;
+            b.fadeBy(brightness);
+            for(int i = 0; i < 333; i++) {
+                assert(b[i].toRGB() == a[i].scale(255 - brightness).toRGB());
+            }
+        }
+    }
+
+    // unaligned pointers and DataWrapper
+    uint8_t raw[400];
+    uint8_t src[400];
+    memset(raw, 3, sizeof(raw));
+    memset(src, 250, sizeof(src));
+    addSaturatePixels(reinterpret_cast<GRB *>(raw + 1), reinterpret_cast<const GRB *>(src + 2), 100);
+    assert(raw[0] == 3 && raw[1] == 253 && raw[300] == 253 && raw[301] == 3);
+    addSaturatePixels(reinterpret_cast<GRB *>(raw + 1), reinterpret_cast<const GRB *>(src + 1), 100);
+    assert(raw[1] == 255 && raw[300] == 255 && raw[301] == 3);
+    DataWrapper<100, GRB> wrapper(raw + 1);
+    wrapper.subSaturate(GRB(0x010203));
+    wrapper.scaleAll(0);
+    assert(raw[1] == 0 && raw[300] == 0 && raw[301] == 3);
+
+    puts("ok");
+    return 0;
+}
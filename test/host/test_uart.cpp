@@ -0,0 +1,84 @@
+// UART encoding tables and Encoder decoded from the line levels of the inverted TX output
+#include "NeoPixelEspExUart.h"
+#include <cassert>
+#include <vector>
+
+using namespace NeoPixelEx;
+
+static_assert(Uart::Encoding6N1::encode(0) == 0b110111 && Uart::Encoding6N1::encode(1) == 0b000111 && Uart::Encoding6N1::encode(2) == 0b110100 && Uart::Encoding6N1::encode(3) == 0b000100, "");
+static_assert(Uart1<900, TimingsWS2812, Uart::Encoding6N1>::kClockDivider == 25, "");
+
+// line levels of the inverted UART: start bit high, data bits inverted LSB first, stop bit low. each bit must
+// start with a high time of 1 or kSamplesPerBit - 1 samples followed by low samples
+template<typename _Encoding>
+static std::vector<uint8_t> decode(const std::vector<uint8_t> &uart, size_t numBytes)
+{
+    std::vector<int> line;
+    for(auto byte: uart) {
+        line.push_back(1);
+        for(int i = 0; i < _Encoding::kDataBits; i++) {
+            line.push_back(!((byte >> i) & 1));
+        }
+        line.push_back(0);
+    }
+    assert(line.size() % _Encoding::kSamplesPerBit == 0);
+    std::vector<uint8_t> result;
+    uint8_t value = 0;
+    int bits = 0;
+    for(size_t i = 0; i < line.size(); i += _Encoding::kSamplesPerBit) {
+        int high = 0;
+        while (high < _Encoding::kSamplesPerBit && line[i + high]) {
+            high++;
+        }
+        for(int j = high; j < _Encoding::kSamplesPerBit; j++) {
+            assert(!line[i + j]);
+        }
+        assert(high == 1 || high == _Encoding::kSamplesPerBit - 1);
+        value = (value << 1) | (high > 1);
+        if (++bits == 8) {
+            result.push_back(value);
+            value = 0;
+            bits = 0;
+        }
+    }
+    // padding bits are 0
+    assert(value == 0);
+    result.resize(numBytes);
+    return result;
+}
+
+template<typename _Encoding>
+static void check(size_t numBytes)
+{
+    std::vector<uint8_t> data(numBytes);
+    for(auto &byte: data) {
+        byte = rand();
+    }
+    Uart::Encoder<_Encoding> encoder(data.data(), numBytes);
+    std::vector<uint8_t> uart;
+    while (encoder.available()) {
+        uart.push_back(encoder.next());
+    }
+    assert(uart.size() == Uart::Encoder<_Encoding>::size(numBytes));
+    assert(decode<_Encoding>(uart, numBytes) == data);
+}
+
+int main()
+{
+    srand(11);
+    for(size_t numBytes: { 1, 2, 3, 4, 90, 91, 300, 1001 }) {
+        check<Uart::Encoding6N1>(numBytes);
+        check<Uart::Encoding7N1>(numBytes);
+    }
+
+    using Output = Uart1<900, TimingsWS2812, Uart::Encoding7N1>;
+    printf("7N1 baud rate %u, clock divider %u\n", Output::kBaudRate, Output::kClockDivider);
+
+    // the FIFO of the register stub is never emptied, show() fills it once and the rest is left to the interrupt
+    Strip<2, 300, GRB, TimingsWS2812, PixelData<300, GRB>, Uart1Output<>> strip;
+    strip.begin();
+    strip.fill(GRB(0x102030));
+    strip.show(128);
+    assert(strip.getOutput().isBusy());
+    return 0;
+}